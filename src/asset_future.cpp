@@ -0,0 +1,26 @@
+#include "asset_future.hpp"
+
+void PendingAsset::complete(IAssetPtr asset) {
+    {
+        std::lock_guard lock(mutex_);
+        asset_ = std::move(asset);
+        done_ = true;
+    }
+    condition_.notify_all();
+}
+
+bool PendingAsset::ready() const {
+    std::lock_guard lock(mutex_);
+    return done_;
+}
+
+auto PendingAsset::asset() const -> IAssetPtr {
+    std::lock_guard lock(mutex_);
+    return asset_;
+}
+
+auto PendingAsset::wait() const -> IAssetPtr {
+    std::unique_lock lock(mutex_);
+    condition_.wait(lock, [this]() { return done_; });
+    return asset_;
+}
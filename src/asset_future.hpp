@@ -0,0 +1,54 @@
+#pragma once
+
+#include <condition_variable>
+#include <mutex>
+
+#include "utils.hpp"
+
+/// Shared state of one asynchronous load, completed exactly once by the asset manager.
+class PendingAsset {
+public:
+    void complete(IAssetPtr asset);
+    bool ready() const;
+    auto asset() const -> IAssetPtr;
+    auto wait() const -> IAssetPtr;
+
+private:
+    mutable std::mutex mutex_;
+    mutable std::condition_variable condition_;
+    IAssetPtr asset_;
+    bool done_{false};
+};
+
+/// Result of AssetManager::loadAsync. Cheap to copy, every copy observes the same load. A default
+/// constructed future is invalid and reads as a failed load.
+template <class T>
+class AssetFuture {
+public:
+    AssetFuture() = default;
+    explicit AssetFuture(std::shared_ptr<PendingAsset> pending) : pending_(std::move(pending)) {
+    }
+
+    bool valid() const {
+        return pending_ != nullptr;
+    }
+
+    /// True once loading finished, successfully or not.
+    bool ready() const {
+        return !pending_ || pending_->ready();
+    }
+
+    /// nullptr while loading and when loading failed
+    auto get() const -> std::shared_ptr<T> {
+        return pending_ ? std::static_pointer_cast<T>(pending_->asset()) : nullptr;
+    }
+
+    /// Blocks until loading finished. Assets uploaded to the GPU complete in
+    /// AssetManager::update, never wait for those on the render thread.
+    auto wait() const -> std::shared_ptr<T> {
+        return pending_ ? std::static_pointer_cast<T>(pending_->wait()) : nullptr;
+    }
+
+private:
+    std::shared_ptr<PendingAsset> pending_;
+};
@@ -0,0 +1,14 @@
+#pragma once
+
+#include "utils.hpp"
+
+/// Dense id of an interned asset path, stable for the whole run. Looking an asset up by id indexes
+/// a table instead of hashing its path, so anything requesting an asset repeatedly should intern
+/// the path once and keep the id.
+struct AssetId {
+    u32 id{0};
+
+    bool valid() const {
+        return id != 0;
+    }
+};
@@ -1,6 +1,31 @@
 #include "asset_manager.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <optional>
+#include <thread>
+#include <utility>
+
+#include "binary_io.hpp"
+#include "file_io.hpp"
 #include "log.hpp"
 
+// how long prefetch sleeps when no load finished since the last look
+const std::chrono::milliseconds PREFETCH_POLL_INTERVAL(1);
+// decoded images are large, an entry is a few times its compressed source
+const u64 MAX_DECODE_CACHE_BYTES = 1024 * 1024 * 1024;
+// decoded images waiting for the render thread, a few frames' worth at the upload budget
+const u32 MAX_QUEUED_UPLOADS = 16;
+// after a scan found too little to evict, stores skip scanning for this fraction of the ids, so
+// scans cost a constant amount per store however many assets are cached
+const u32 EVICTION_RESCAN_FRACTION = 8;
+
+AssetManager::~AssetManager() {
+    for(auto& block : slotBlocks_) {
+        delete[] block.load(std::memory_order_relaxed);
+    }
+}
+
 AssetManager* AssetManager::get() {
     static AssetManager instance;
     return &instance;
@@ -10,10 +35,278 @@ void AssetManager::setAssetRoot(const std::string& assetRoot) {
     assetRoot_ = assetRoot;
 }
 
-void AssetManager::unload(const std::string& assetPath) {
+void AssetManager::setCookedRoot(const std::string& cookedRoot) {
+    cookedRoot_ = cookedRoot;
+}
+
+bool AssetManager::openPack(const std::string& filePath) {
+    return pack_.open(filePath);
+}
+
+void AssetManager::setDecodeCache(const std::string& cacheRoot) {
+    decodeCacheRoot_ = cacheRoot;
+    if(!cacheRoot.empty()) {
+        std::error_code error;
+        std::filesystem::create_directories(cacheRoot, error);
+        trimDecodeCache();
+    }
+}
+
+auto AssetManager::intern(const std::string& assetPath) -> AssetId {
+    if(assetPath.empty()) {
+        return {};
+    }
+
+    auto& shard = pathShard(assetPath);
+    std::lock_guard lock(shard.mutex);
+    if(auto it = shard.ids.find(assetPath); it != shard.ids.end()) {
+        return {it->second};
+    }
+
+    u32 id = nextId_.fetch_add(1, std::memory_order_relaxed);
+    u32 block = id / ASSET_SLOT_BLOCK_SIZE;
+    if(block >= ASSET_SLOT_BLOCK_COUNT) {
+        FATAL_ERROR("[ASSET MANAGER]: out of asset ids");
+    }
+    if(!slotBlocks_[block].load(std::memory_order_acquire)) {
+        std::lock_guard blockLock(slotBlocksMutex_);
+        if(!slotBlocks_[block].load(std::memory_order_relaxed)) {
+            slotBlocks_[block].store(new Slot[ASSET_SLOT_BLOCK_SIZE], std::memory_order_release);
+        }
+    }
+
+    // whoever gets the id from now on got it through this shard's lock, which publishes the path
+    slot({id})->path = assetPath;
+    shard.ids.emplace(assetPath, id);
+    return {id};
+}
+
+auto AssetManager::path(AssetId id) const -> std::string {
+    auto interned = slot(id);
+    return interned ? interned->path : std::string();
+}
+
+void AssetManager::update(std::chrono::microseconds budget) {
+    auto start = std::chrono::steady_clock::now();
+    for(auto& [type, loader] : assetLoaders_) {
+        loader->update();
+    }
+    while(true) {
+        std::optional<Upload> upload;
+        {
+            std::lock_guard lock(uploadsMutex_);
+            if(uploads_.empty()) {
+                return;
+            }
+            upload.emplace(std::move(uploads_.front()));
+            uploads_.pop_front();
+            uploadReservations_--;
+        }
+        uploadSpace_.notify_one();
+
+        auto asset = store(upload->id, upload->type, upload->loader->upload(upload->decoded));
+        finishLoad(upload->id, asset, *upload->pending);
+
+        if(budget != std::chrono::microseconds::zero() &&
+           std::chrono::steady_clock::now() - start >= budget) {
+            return;
+        }
+    }
+}
+
+void AssetManager::cancelUploads() {
+    std::deque<Upload> cancelled;
+    {
+        std::lock_guard lock(uploadsMutex_);
+        uploadsCancelled_ = true;
+        cancelled.swap(uploads_);
+        uploadReservations_ -= static_cast<u32>(cancelled.size());
+    }
+    uploadSpace_.notify_all();
+
+    for(auto& upload : cancelled) {
+        finishLoad(upload.id, nullptr, *upload.pending);
+    }
+}
+
+auto AssetManager::prefetch(
+    const std::vector<AssetReference>& roots, const PrefetchProgress& progress) -> u32 {
+    struct InFlight {
+        std::type_index type;
+        std::shared_ptr<PendingAsset> pending;
+    };
+
+    std::unordered_set<std::string> seen;
+    std::vector<InFlight> inFlight;
+    auto request = [&](const AssetReference& reference) {
+        if(reference.path.empty() || !seen.insert(reference.path).second) {
+            return;
+        }
+        inFlight.push_back(
+            {reference.type, startLoad(reference.type, intern(reference.path))});
+    };
+    for(auto& root : roots) {
+        request(root);
+    }
+
+    u32 finished = 0;
+    u32 failed = 0;
+    std::vector<AssetReference> references;
+    while(!inFlight.empty()) {
+        update();
+
+        u32 finishedBefore = finished;
+        // new requests are appended while walking, hence the index
+        for(size_t i = 0; i < inFlight.size();) {
+            if(!inFlight[i].pending->ready()) {
+                i++;
+                continue;
+            }
+
+            auto type = inFlight[i].type;
+            auto asset = inFlight[i].pending->asset();
+            inFlight[i] = inFlight.back();
+            inFlight.pop_back();
+            finished++;
+
+            if(!asset) {
+                failed++;
+                continue;
+            }
+            references.clear();
+            if(auto loader = findLoader(type)) {
+                loader->references(*asset, references);
+            }
+            for(auto& reference : references) {
+                request(reference);
+            }
+        }
+
+        if(progress && finished != finishedBefore) {
+            progress(finished, static_cast<u32>(seen.size()));
+        }
+        if(finished == finishedBefore) {
+            std::this_thread::sleep_for(PREFETCH_POLL_INTERVAL);
+        }
+    }
+    return failed;
+}
+
+auto AssetManager::cook(const std::vector<AssetReference>& roots, const std::string& packPath)
+    -> u32 {
+    std::unordered_set<std::string> seen;
+    std::vector<PackEntry> packEntries;
+    std::vector<AssetReference> queue = roots;
+    std::vector<AssetReference> references;
+    u32 cooked = 0;
+    u32 failed = 0;
+    while(!queue.empty()) {
+        auto reference = queue.back();
+        queue.pop_back();
+        if(reference.path.empty() || !seen.insert(reference.path).second) {
+            continue;
+        }
+
+        auto loader = findLoader(reference.type);
+        auto path = getAssetPath(reference.path);
+        if(!loader || !std::filesystem::exists(path)) {
+            ERROR("[ASSET MANAGER]: cannot cook " + reference.path);
+            failed++;
+            continue;
+        }
+
+        auto asset = loader->needsUpload() ? loader->decode(*this, path.generic_string())
+                                           : loader->load(*this, path.generic_string());
+        if(!asset) {
+            failed++;
+            continue;
+        }
+
+        BinaryWriter writer;
+        writer.writeHeader();
+        writer.writeU64(sourceStamp(reference.path));
+        if(!loader->cook(*asset, writer)) {
+            // no cooked form, loaded from source at runtime
+        } else if(!packPath.empty()) {
+            packEntries.push_back({reference.path, writer.data()});
+            cooked++;
+        } else {
+            auto cookedPath = getCookedPath(reference.path);
+            std::error_code error;
+            std::filesystem::create_directories(cookedPath.parent_path(), error);
+            if(!FileIO::writeBinaryFile(cookedPath.generic_string(), writer.data())) {
+                ERROR("[ASSET MANAGER]: failed to write " + cookedPath.generic_string());
+                failed++;
+            } else {
+                cooked++;
+            }
+        }
 
-    if(auto it = assets_.find(assetPath); it != assets_.end()) {
-        assets_.erase(it);
+        references.clear();
+        loader->references(*asset, references);
+        queue.insert(queue.end(), references.begin(), references.end());
+    }
+
+    if(!packPath.empty()) {
+        auto packFile = std::filesystem::absolute(packPath);
+        std::error_code error;
+        std::filesystem::create_directories(packFile.parent_path(), error);
+        // sorted, so the same assets always produce the same pack
+        std::ranges::sort(packEntries, {}, &PackEntry::path);
+        if(!PackFile::write(packFile.generic_string(), packEntries)) {
+            failed += static_cast<u32>(packEntries.size());
+            cooked = 0;
+        }
+    }
+
+    INFO(
+        "[ASSET MANAGER]: cooked " + std::to_string(cooked) + " of " +
+        std::to_string(seen.size()) + " assets");
+    return failed;
+}
+
+bool AssetManager::watchAssets() {
+    return watcher_.start(assetRoot_);
+}
+
+void AssetManager::reloadChanged() {
+    for(auto& assetPath : watcher_.poll()) {
+        reload(assetPath);
+    }
+}
+
+void AssetManager::setMemoryBudget(size_t bytes) {
+    memoryBudget_.store(bytes, std::memory_order_relaxed);
+    evictUnused(true);
+}
+
+auto AssetManager::memoryBudget() const -> size_t {
+    return memoryBudget_.load(std::memory_order_relaxed);
+}
+
+auto AssetManager::residentBytes() const -> size_t {
+    std::lock_guard lock(accountingMutex_);
+    return totalBytes_;
+}
+
+auto AssetManager::residentBytes(std::type_index type) const -> size_t {
+    std::lock_guard lock(accountingMutex_);
+    auto it = residentBytes_.find(type);
+    return it != residentBytes_.end() ? it->second : 0;
+}
+
+void AssetManager::trim() {
+    evictUnused(true);
+}
+
+void AssetManager::unload(const std::string& assetPath) {
+    auto id = find(assetPath);
+    if(!id.valid()) {
+        return;
+    }
+    std::lock_guard lock(slotLock(id));
+    if(auto cached = slot(id); cached->cached) {
+        erase(*cached);
     }
 }
 
@@ -21,3 +314,538 @@ auto AssetManager::getAssetPath(const std::string& assetPath) const -> std::file
     return std::filesystem::path(assetRoot_) / assetPath;
 }
 
+auto AssetManager::getCookedPath(const std::string& assetPath) const -> std::filesystem::path {
+    return std::filesystem::path(cookedRoot_) / (assetPath + ".bin");
+}
+
+bool AssetManager::exists(const std::string& assetPath) const {
+    if(pack_.contains(assetPath) || std::filesystem::exists(getAssetPath(assetPath))) {
+        return true;
+    }
+    return !cookedRoot_.empty() && std::filesystem::exists(getCookedPath(assetPath));
+}
+
+auto AssetManager::read(IAssetLoader& loader, const std::string& assetPath) -> IAssetPtr {
+    // read in place, the mapping outlives every load
+    if(auto blob = pack_.find(assetPath); !blob.empty()) {
+        if(auto asset = readCooked(loader, assetPath, blob)) {
+            return asset;
+        }
+        INFO("[ASSET MANAGER]: packed " + assetPath + " is outdated, trying the next source");
+    }
+
+    if(!cookedRoot_.empty()) {
+        auto cookedPath = getCookedPath(assetPath);
+        if(std::filesystem::exists(cookedPath)) {
+            auto blob = FileIO::readBinaryFile(cookedPath.generic_string());
+            // an unreadable blob fails the header check like an outdated one
+            auto bytes = blob ? std::as_bytes(std::span(*blob)) : std::span<const std::byte>();
+            if(auto asset = readCooked(loader, assetPath, bytes)) {
+                return asset;
+            }
+            INFO(
+                "[ASSET MANAGER]: " + cookedPath.generic_string() +
+                " is outdated, loading the source");
+        }
+    }
+
+    if(loader.needsUpload() && !decodeCacheRoot_.empty()) {
+        return readDecodeCache(loader, assetPath);
+    }
+    auto path = getAssetPath(assetPath).generic_string();
+    return loader.needsUpload() ? loader.decode(*this, path) : loader.load(*this, path);
+}
+
+auto AssetManager::readDecodeCache(IAssetLoader& loader, const std::string& assetPath)
+    -> IAssetPtr {
+    auto path = getAssetPath(assetPath).generic_string();
+    auto source = FileIO::readBinaryFile(path);
+    if(!source) {
+        return loader.decode(*this, path);
+    }
+
+    // Hashing the compressed source is far cheaper than inflating it. The size and the hash are
+    // checked again, a cache file may be cut short or belong to a colliding source.
+    u64 hash = hashBytes(*source);
+    char digits[16];
+    auto hashEnd = std::to_chars(std::begin(digits), std::end(digits), hash, 16).ptr;
+    auto cacheFile =
+        std::filesystem::path(decodeCacheRoot_) / (std::string(digits, hashEnd) + ".bin");
+    if(auto blob = FileIO::readBinaryFile(cacheFile.generic_string())) {
+        BinaryReader reader(std::as_bytes(std::span(*blob)));
+        if(reader.readHeader() && reader.readU64() == hash &&
+           reader.readU64() == source->size()) {
+            if(auto asset = loader.loadCooked(*this, reader)) {
+                // marks it as used for trimming
+                std::error_code error;
+                std::filesystem::last_write_time(
+                    cacheFile, std::filesystem::file_time_type::clock::now(), error);
+                return asset;
+            }
+        }
+        INFO("[ASSET MANAGER]: decode cache entry of " + assetPath + " is invalid, decoding");
+    }
+
+    auto decoded = loader.decode(*this, path, *source);
+    if(!decoded) {
+        return nullptr;
+    }
+
+    BinaryWriter writer;
+    writer.writeHeader();
+    writer.writeU64(hash);
+    writer.writeU64(source->size());
+    if(loader.cook(*decoded, writer)) {
+        // renamed into place, loads of other paths with the same content never see half a file
+        auto partialFile = cacheFile;
+        partialFile +=
+            "." + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id())) + ".tmp";
+        std::error_code error;
+        if(!FileIO::writeBinaryFile(partialFile.generic_string(), writer.data())) {
+            ERROR("[ASSET MANAGER]: failed to write " + partialFile.generic_string());
+        } else {
+            std::filesystem::rename(partialFile, cacheFile, error);
+            if(error) {
+                std::filesystem::remove(partialFile, error);
+            }
+        }
+    }
+    return decoded;
+}
+
+void AssetManager::trimDecodeCache() {
+    struct Entry {
+        std::filesystem::path path;
+        std::filesystem::file_time_type lastUse;
+        u64 size;
+    };
+
+    std::vector<Entry> entries;
+    std::error_code error;
+    for(auto& file : std::filesystem::directory_iterator(decodeCacheRoot_, error)) {
+        if(file.is_regular_file(error) && file.path().extension() == ".bin") {
+            entries.push_back({file.path(), file.last_write_time(error), file.file_size(error)});
+        }
+    }
+
+    // newest first, everything after the cap is removed
+    std::ranges::sort(entries, std::greater{}, &Entry::lastUse);
+    u64 total = 0;
+    u32 removed = 0;
+    for(auto& entry : entries) {
+        total += entry.size;
+        if(total > MAX_DECODE_CACHE_BYTES && std::filesystem::remove(entry.path, error)) {
+            removed++;
+        }
+    }
+    if(removed > 0) {
+        INFO(
+            "[ASSET MANAGER]: removed " + std::to_string(removed) +
+            " least recently used decode cache entries");
+    }
+}
+
+auto AssetManager::readCooked(
+    IAssetLoader& loader, const std::string& assetPath, std::span<const std::byte> blob)
+    -> IAssetPtr {
+    BinaryReader reader(blob);
+    if(!reader.readHeader()) {
+        return nullptr;
+    }
+    // shipped builds may leave the sources out, their blobs are current by definition
+    u64 stamp = reader.readU64();
+    if(u64 current = sourceStamp(assetPath); current != 0 && current != stamp) {
+        return nullptr;
+    }
+    return loader.loadCooked(*this, reader);
+}
+
+auto AssetManager::sourceStamp(const std::string& assetPath) const -> u64 {
+    auto path = getAssetPath(assetPath);
+    std::error_code error;
+    auto size = std::filesystem::file_size(path, error);
+    if(error) {
+        return 0;
+    }
+    auto writeTime = std::filesystem::last_write_time(path, error);
+    if(error) {
+        return 0;
+    }
+    u64 values[] = {static_cast<u64>(size), static_cast<u64>(writeTime.time_since_epoch().count())};
+    return hashBytes(std::span(reinterpret_cast<const char*>(values), sizeof(values)));
+}
+
+auto AssetManager::findLoader(std::type_index type) -> std::shared_ptr<IAssetLoader> {
+    // loaders are registered during init, before any other thread loads
+    auto loaderIter = assetLoaders_.find(type);
+    if(loaderIter == assetLoaders_.end()) {
+        ERROR("[ASSET MANAGER]: loader " + std::string(type.name()) + " not found");
+        return nullptr;
+    }
+    return loaderIter->second;
+}
+
+auto AssetManager::pathShard(const std::string& assetPath) -> PathShard& {
+    return pathShards_[std::hash<std::string>{}(assetPath) % ASSET_SHARD_COUNT];
+}
+
+auto AssetManager::find(const std::string& assetPath) -> AssetId {
+    auto& shard = pathShard(assetPath);
+    std::lock_guard lock(shard.mutex);
+    auto it = shard.ids.find(assetPath);
+    return it != shard.ids.end() ? AssetId{it->second} : AssetId{};
+}
+
+auto AssetManager::slot(AssetId id) const -> Slot* {
+    if(!id.valid()) {
+        return nullptr;
+    }
+    u32 block = id.id / ASSET_SLOT_BLOCK_SIZE;
+    if(block >= ASSET_SLOT_BLOCK_COUNT) {
+        return nullptr;
+    }
+    Slot* slots = slotBlocks_[block].load(std::memory_order_acquire);
+    return slots ? &slots[id.id % ASSET_SLOT_BLOCK_SIZE] : nullptr;
+}
+
+auto AssetManager::slotLock(AssetId id) const -> std::mutex& {
+    return slotLocks_[id.id % ASSET_SHARD_COUNT];
+}
+
+auto AssetManager::loadNow(std::type_index type, AssetId id) -> IAssetPtr {
+    auto cached = slot(id);
+    if(!cached) {
+        return nullptr;
+    }
+
+    // check if already cached or in flight
+    std::shared_ptr<PendingAsset> pending;
+    std::shared_ptr<PendingAsset> ownPending;
+    {
+        std::lock_guard lock(slotLock(id));
+        if(cached->cached) {
+            return use(*cached);
+        }
+        if(cached->pending && cached->loading) {
+            pending = cached->pending;
+        } else {
+            // nobody started loading yet, a queued asynchronous load is taken over
+            if(!cached->pending) {
+                cached->pending = std::make_shared<PendingAsset>();
+            }
+            cached->loading = true;
+            ownPending = cached->pending;
+        }
+    }
+
+    // find appropriate loader
+    auto loader = findLoader(type);
+
+    if(pending) {
+        // Someone else is loading it. Uploads only finish in update, and synchronous loads of
+        // upload assets only happen on the render thread, so this is the thread to finish them.
+        if(loader && loader->needsUpload()) {
+            while(!pending->ready()) {
+                update();
+                std::this_thread::sleep_for(PREFETCH_POLL_INTERVAL);
+            }
+        }
+        return pending->wait();
+    }
+
+    if(!loader) {
+        finishLoad(id, nullptr, *ownPending);
+        return nullptr;
+    }
+
+    // validate path, missing ones are remembered
+    if(!exists(cached->path)) {
+        ERROR("[ASSET MANAGER] asset path " + cached->path + " does not exist");
+        store(id, type, nullptr);
+        finishLoad(id, nullptr, *ownPending);
+        return nullptr;
+    }
+
+    // load asset via loader
+    auto asset = read(*loader, cached->path);
+    if(asset && loader->needsUpload()) {
+        asset = loader->upload(asset);
+    }
+
+    // store asset
+    asset = store(id, type, asset);
+    finishLoad(id, asset, *ownPending);
+    return asset;
+}
+
+auto AssetManager::store(AssetId id, std::type_index type, IAssetPtr asset) -> IAssetPtr {
+    // loaders are registered during init, the lookup does not need a lock
+    auto loader = findLoader(type);
+    size_t bytes = asset && loader ? loader->memoryUsage(*asset) : 0;
+
+    auto cached = slot(id);
+    if(!cached) {
+        return asset;
+    }
+    {
+        std::lock_guard lock(slotLock(id));
+        // a reload may have been quicker, everyone shares the first
+        if(cached->cached) {
+            return use(*cached);
+        }
+
+        cached->cached = true;
+        cached->asset = asset;
+        cached->type = type;
+        cached->loader = std::move(loader);
+        use(*cached);
+        account(*cached, bytes);
+    }
+    evictUnused();
+    return asset;
+}
+
+auto AssetManager::use(Slot& slot) -> IAssetPtr {
+    slot.lastUse = useClock_.fetch_add(1, std::memory_order_relaxed);
+    return slot.asset;
+}
+
+void AssetManager::account(Slot& slot, size_t bytes) {
+    std::lock_guard lock(accountingMutex_);
+    auto& resident = residentBytes_[slot.type];
+    resident = resident - slot.bytes + bytes;
+    totalBytes_ = totalBytes_ - slot.bytes + bytes;
+    slot.bytes = bytes;
+}
+
+void AssetManager::erase(Slot& slot) {
+    // the id and the path stay interned, only the asset goes
+    account(slot, 0);
+    slot.cached = false;
+    slot.asset = nullptr;
+    slot.loader = nullptr;
+}
+
+void AssetManager::evictUnused(bool rescan) {
+    size_t budget = memoryBudget_.load(std::memory_order_relaxed);
+    if(budget == 0 || residentBytes() <= budget) {
+        return;
+    }
+    // one eviction pass at a time is plenty, the others would find nothing left to do
+    std::unique_lock evictionLock(evictionMutex_, std::try_to_lock);
+    if(!evictionLock.owns_lock()) {
+        return;
+    }
+
+    if(rescan) {
+        evictionScanSkips_ = 0;
+    }
+    bool scanned = false;
+    while(residentBytes() > budget) {
+        if(evictionCandidates_.empty()) {
+            if(scanned) {
+                break;
+            }
+            if(evictionScanSkips_ > 0) {
+                evictionScanSkips_--;
+                return;
+            }
+            scanEvictionCandidates();
+            scanned = true;
+            continue;
+        }
+
+        auto candidate = evictionCandidates_.back();
+        evictionCandidates_.pop_back();
+        // used again since the scan, check once more
+        std::lock_guard lock(slotLock(candidate.id));
+        auto cached = slot(candidate.id);
+        if(cached->cached && cached->lastUse == candidate.lastUse &&
+           cached->asset.use_count() == 1) {
+            erase(*cached);
+        }
+    }
+
+    if(residentBytes() > budget) {
+        // everything left is referenced, the stores right after would scan in vain
+        evictionScanSkips_ = nextId_.load(std::memory_order_relaxed) / EVICTION_RESCAN_FRACTION;
+        ERROR_ONCE(
+            "[ASSET MANAGER]: assets in use exceed the budget of " + std::to_string(budget) +
+            " bytes");
+    }
+}
+
+void AssetManager::scanEvictionCandidates() {
+    // Only the cache holding the last reference makes an asset unused. Nobody can take a new
+    // reference without the slot's lock, so the count cannot go up behind our back.
+    evictionCandidates_.clear();
+    u32 idCount = nextId_.load(std::memory_order_relaxed);
+    for(u32 i = 1; i < idCount; i++) {
+        auto cached = slot({i});
+        if(!cached) {
+            continue;
+        }
+        std::lock_guard lock(slotLock({i}));
+        if(cached->cached && cached->bytes > 0 && cached->asset.use_count() == 1) {
+            evictionCandidates_.push_back({cached->lastUse, {i}});
+        }
+    }
+    std::ranges::sort(evictionCandidates_, std::ranges::greater{}, &EvictionCandidate::lastUse);
+}
+
+void AssetManager::reload(const std::string& assetPath) {
+    auto id = find(assetPath);
+    auto cached = slot(id);
+    if(!cached) {
+        // never loaded, the next load reads the new file anyway
+        return;
+    }
+
+    std::shared_ptr<IAssetLoader> loader;
+    {
+        std::lock_guard lock(slotLock(id));
+        if(!cached->cached) {
+            return;
+        }
+        // remembered as missing or failed, forgetting that makes the next request load the new
+        // file
+        if(!cached->asset) {
+            erase(*cached);
+            return;
+        }
+        loader = cached->loader;
+    }
+
+    // uploads belong to the render thread, which this does not run on
+    if(!loader || loader->needsUpload()) {
+        INFO("[ASSET MANAGER]: " + assetPath + " changed, restart to see it");
+        return;
+    }
+
+    auto fresh = loader->load(*this, getAssetPath(assetPath).generic_string());
+    if(!fresh) {
+        ERROR("[ASSET MANAGER]: failed to reload " + assetPath + ", keeping the old version");
+        return;
+    }
+
+    size_t bytes = loader->memoryUsage(*fresh);
+    IAssetPtr previous;
+    {
+        std::lock_guard lock(slotLock(id));
+        // evicted meanwhile, the next load reads the new file
+        if(!cached->cached) {
+            return;
+        }
+        previous = std::exchange(cached->asset, fresh);
+        account(*cached, bytes);
+    }
+    onReloaded(id, previous, fresh);
+    INFO("[ASSET MANAGER]: reloaded " + assetPath);
+}
+
+auto AssetManager::startLoad(std::type_index type, AssetId id) -> std::shared_ptr<PendingAsset> {
+    auto cached = slot(id);
+    if(!cached) {
+        auto failed = std::make_shared<PendingAsset>();
+        failed->complete(nullptr);
+        return failed;
+    }
+
+    auto pending = std::make_shared<PendingAsset>();
+    {
+        std::lock_guard lock(slotLock(id));
+        if(cached->cached) {
+            pending->complete(use(*cached));
+            return pending;
+        }
+        if(cached->pending) {
+            return cached->pending;
+        }
+        cached->pending = pending;
+    }
+
+    auto loader = findLoader(type);
+    if(!loader) {
+        finishLoad(id, nullptr, *pending);
+        return pending;
+    }
+
+    // the returned std::future is not needed, completion is reported through the pending asset
+    ThreadPool::loading().submit([this, type, loader, id, pending]() {
+        loadJob(type, loader, id, slot(id)->path, pending);
+    });
+    return pending;
+}
+
+void AssetManager::loadJob(
+    std::type_index type, std::shared_ptr<IAssetLoader> loader, AssetId id,
+    std::string assetPath, std::shared_ptr<PendingAsset> pending) {
+    {
+        // a synchronous load may have taken this over while it was queued
+        std::lock_guard lock(slotLock(id));
+        auto cached = slot(id);
+        if(cached->pending != pending || cached->loading) {
+            return;
+        }
+        cached->loading = true;
+    }
+
+    if(!exists(assetPath)) {
+        ERROR("[ASSET MANAGER] asset path " + assetPath + " does not exist");
+        store(id, type, nullptr);
+        finishLoad(id, nullptr, *pending);
+        return;
+    }
+
+    if(!loader->needsUpload()) {
+        auto asset = store(id, type, read(*loader, assetPath));
+        finishLoad(id, asset, *pending);
+        return;
+    }
+
+    // the place is taken before decoding, so no more decoded images exist than the queue holds
+    {
+        std::unique_lock lock(uploadsMutex_);
+        uploadSpace_.wait(lock, [this]() {
+            return uploadsCancelled_ || uploadReservations_ < MAX_QUEUED_UPLOADS;
+        });
+        if(uploadsCancelled_) {
+            lock.unlock();
+            finishLoad(id, nullptr, *pending);
+            return;
+        }
+        uploadReservations_++;
+    }
+
+    auto decoded = read(*loader, assetPath);
+    if(!decoded) {
+        {
+            std::lock_guard lock(uploadsMutex_);
+            uploadReservations_--;
+        }
+        uploadSpace_.notify_one();
+        store(id, type, nullptr);
+        finishLoad(id, nullptr, *pending);
+        return;
+    }
+
+    std::unique_lock lock(uploadsMutex_);
+    if(uploadsCancelled_) {
+        uploadReservations_--;
+        lock.unlock();
+        finishLoad(id, nullptr, *pending);
+        return;
+    }
+    uploads_.push_back({id, assetPath, type, loader, decoded, pending});
+}
+
+void AssetManager::finishLoad(AssetId id, IAssetPtr asset, PendingAsset& pending) {
+    if(auto cached = slot(id)) {
+        std::lock_guard lock(slotLock(id));
+        if(cached->pending.get() == &pending) {
+            cached->pending = nullptr;
+            cached->loading = false;
+        }
+    }
+    pending.complete(std::move(asset));
+}
@@ -1,30 +1,250 @@
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+#include "asset_future.hpp"
+#include "asset_id.hpp"
+#include "asset_watcher.hpp"
+#include "event.h"
 #include "loaders/i_asset_loader.hpp"
 #include "log.hpp"
+#include "pack_file.hpp"
+#include "thread_pool.hpp"
+
+// lock stripes of the path table and of the asset slots
+const u32 ASSET_SHARD_COUNT = 16;
+// slots are allocated in blocks that never move, so ids index them without a lock
+const u32 ASSET_SLOT_BLOCK_SIZE = 1024;
+const u32 ASSET_SLOT_BLOCK_COUNT = 4096;
 
+/// Shared by the simulation, the render thread and the loading workers, every member is safe to
+/// call from any of them unless noted otherwise. The path table and the asset slots are split
+/// into lock striped shards, so threads loading different assets rarely meet. Loaders run
+/// without any lock held and load their dependencies through the manager.
+///
+/// Loads are single flight: a request for an asset some other thread is loading waits for that
+/// load instead of starting its own. An asynchronous load still queued on the loading pool is
+/// taken over by the synchronous request, so loaders never wait for jobs queued behind them.
+///
+/// The cache keeps track of what its assets occupy. Once that exceeds the memory budget, the
+/// least recently requested assets nobody else holds a reference to are dropped.
 class AssetManager {
 public:
     static AssetManager* get();
     void setAssetRoot(const std::string& assetRoot);
+    /// Where ces_cook put its blobs. Assets with a cooked blob load from it, everything else from
+    /// its source file, as do assets whose source was edited after cooking.
+    void setCookedRoot(const std::string& cookedRoot);
+    /// Maps a pack written by ces_cook. Its entries take precedence over loose cooked blobs and
+    /// are read in place, without a copy. Call during init, before anything loads.
+    bool openPack(const std::string& filePath);
+    /// Where decoded images are kept between runs, one file per source content hash. Upload
+    /// loaders without a cooked blob load from there instead of decoding the source again, and
+    /// write what they had to decode. Hits renew an entry, so entries of changed sources age
+    /// and are the first removed when the cache is set and has outgrown its size cap.
+    /// Empty, the default, disables it.
+    void setDecodeCache(const std::string& cacheRoot);
 
 public:
     template <class T>
     void registerLoader(std::shared_ptr<IAssetLoader> loader);
 
+    /// Maps the path to its id, the same one for the whole run. The empty path is invalid. Any
+    /// thread.
+    auto intern(const std::string& assetPath) -> AssetId;
+    auto path(AssetId id) const -> std::string;
+
+    /// Paths that exist nowhere and failed loads are remembered like loaded assets, requesting
+    /// them again neither touches the disk nor logs again.
+    template <class T>
+    auto load(AssetId id) -> std::shared_ptr<T>;
     template <class T>
     auto load(const std::string& assetPath) -> std::shared_ptr<T>;
 
+    /// Loads on the loading pool and returns immediately, the future is ready right away for
+    /// cached assets. Requests for a path already loading share its future.
+    template <class T>
+    auto loadAsync(AssetId id) -> AssetFuture<T>;
+    template <class T>
+    auto loadAsync(const std::string& assetPath) -> AssetFuture<T>;
+
+    /// Finishes asynchronous loads waiting for the GPU, oldest first. Render thread, once per
+    /// frame. With a budget it stops starting uploads once the budget is spent, the rest wait for
+    /// the next frame. At least one upload runs per call, so the queue drains at any budget.
+    /// Decoding waits while the queue is full, so it never gets far ahead of the uploads. The
+    /// loaders free what evicted assets held on the GPU first.
+    void update(std::chrono::microseconds budget = std::chrono::microseconds::zero());
+    /// Fails the queued uploads and every later one, and releases the decode workers waiting for
+    /// room. Render thread, once it stops calling update for good.
+    void cancelUploads();
+
+    using PrefetchProgress = std::function<void(u32 finished, u32 total)>;
+
+    /// Loads the given assets and everything they refer to, transitively, in parallel on the
+    /// loading pool. Blocks until all of them are done and reports progress after each finished
+    /// asset, the total grows as references are discovered. Uploads run on the calling thread,
+    /// so this is for the render thread. Returns the number of assets that failed to load.
+    auto prefetch(const std::vector<AssetReference>& roots, const PrefetchProgress& progress)
+        -> u32;
+
+    /// Writes a cooked blob for each of the assets and everything they refer to, always parsed
+    /// from source. The blobs go into a single pack when a pack path is given, loose into the
+    /// cooked root otherwise. Returns the number of assets that failed to load or to be written.
+    auto cook(const std::vector<AssetReference>& roots, const std::string& packPath = "") -> u32;
+
+    /// Watches the asset root for edits, reloadChanged picks them up. Development only.
+    bool watchAssets();
+    /// Reloads the cached assets whose source files changed, from source since their cooked
+    /// blobs are stale now. The cache entry is replaced by the fresh asset, the previous one is
+    /// never written to, so loading workers still reading it see a consistent version. Later
+    /// loads get the fresh one, holders learn about it through onReloaded. Simulation thread,
+    /// between ticks.
+    void reloadChanged();
+    /// Fired by reloadChanged for every replaced asset, with the previous and the fresh version,
+    /// components holding the previous one swap it. Subscribe on the simulation thread.
+    EventF<AssetManager, AssetId, IAssetPtr, IAssetPtr> onReloaded;
+
+    /// 0, the default, never evicts anything.
+    void setMemoryBudget(size_t bytes);
+    auto memoryBudget() const -> size_t;
+    /// Bytes occupied by the cached assets, all of them or those of one type.
+    auto residentBytes() const -> size_t;
+    auto residentBytes(std::type_index type) const -> size_t;
+    template <class T>
+    auto residentBytes() const -> size_t;
+    /// Evicts unreferenced assets until the cache fits the budget again. Happens on every store
+    /// anyway, but stores skip the scan for a while after one found nothing to evict. Call it
+    /// after dropping a lot of references at once, like after leaving a level.
+    void trim();
+
     void unload(const std::string& assetPath);
     auto getAssetPath(const std::string& assetPath) const -> std::filesystem::path;
+    auto getCookedPath(const std::string& assetPath) const -> std::filesystem::path;
+    /// True when the path is packed, cooked or has a source file, without loading anything.
+    bool exists(const std::string& assetPath) const;
+
+private:
+    /// Everything known about one interned path. The path is set once when interning, everything
+    /// else is guarded by the slot's shard.
+    struct Slot {
+        std::string path;
+        // set for loaded assets as well as for missing paths and failed loads, asset is null then
+        bool cached{false};
+        IAssetPtr asset;
+        std::type_index type{typeid(void)};
+        std::shared_ptr<IAssetLoader> loader;
+        size_t bytes{0};
+        u64 lastUse{0};
+        // the load in flight, a queued asynchronous one until some thread started loading
+        std::shared_ptr<PendingAsset> pending;
+        bool loading{false};
+    };
+
+    // an unreferenced asset as of the last eviction scan
+    struct EvictionCandidate {
+        u64 lastUse;
+        AssetId id;
+    };
+
+    struct PathShard {
+        std::mutex mutex;
+        std::unordered_map<std::string, u32> ids;
+    };
+
+    struct Upload {
+        AssetId id;
+        std::string assetPath;
+        std::type_index type;
+        std::shared_ptr<IAssetLoader> loader;
+        IAssetPtr decoded;
+        std::shared_ptr<PendingAsset> pending;
+    };
+
+    auto findLoader(std::type_index type) -> std::shared_ptr<IAssetLoader>;
+    /// The cooked blob when there is a current one, the source otherwise. Upload loaders return
+    /// the decoded asset.
+    auto read(IAssetLoader& loader, const std::string& assetPath) -> IAssetPtr;
+    /// Decodes the source through the decode cache.
+    auto readDecodeCache(IAssetLoader& loader, const std::string& assetPath) -> IAssetPtr;
+    /// Removes the least recently used entries beyond MAX_DECODE_CACHE_BYTES.
+    void trimDecodeCache();
+    /// Null when the blob is of another format version or older than the source.
+    auto readCooked(IAssetLoader& loader, const std::string& assetPath,
+                    std::span<const std::byte> blob) -> IAssetPtr;
+    /// Size and write time of the source file folded into one value, zero without a source.
+    /// Cooked blobs record it, a blob whose stamp no longer matches was cooked before an edit.
+    auto sourceStamp(const std::string& assetPath) const -> u64;
+
+    auto pathShard(const std::string& assetPath) -> PathShard&;
+    /// The id of an already interned path, invalid otherwise.
+    auto find(const std::string& assetPath) -> AssetId;
+    /// nullptr for anything but interned ids.
+    auto slot(AssetId id) const -> Slot*;
+    auto slotLock(AssetId id) const -> std::mutex&;
+
+    /// Synchronous single flight load, the untyped part of load.
+    auto loadNow(std::type_index type, AssetId id) -> IAssetPtr;
+    /// Failed loads are stored as well and not retried.
+    auto store(AssetId id, std::type_index type, IAssetPtr asset) -> IAssetPtr;
+    /// Hands out a cached asset and marks it as recently used. Requires the slot's lock.
+    auto use(Slot& slot) -> IAssetPtr;
+    /// Requires the slot's lock.
+    void account(Slot& slot, size_t bytes);
+    void erase(Slot& slot);
+    /// Stores evict the candidates left from the last scan, oldest first, and only scan all slots
+    /// once those are used up. rescan scans even while stores would skip it.
+    void evictUnused(bool rescan = false);
+    /// Requires evictionMutex_.
+    void scanEvictionCandidates();
+    void reload(const std::string& assetPath);
+    auto startLoad(std::type_index type, AssetId id) -> std::shared_ptr<PendingAsset>;
+    void loadJob(
+        std::type_index type, std::shared_ptr<IAssetLoader> loader, AssetId id,
+        std::string assetPath, std::shared_ptr<PendingAsset> pending);
+    void finishLoad(AssetId id, IAssetPtr asset, PendingAsset& pending);
 
 private:
     std::string assetRoot_;
-    std::unordered_map<std::string, IAssetPtr> assets_;
+    std::string cookedRoot_;
+    std::string decodeCacheRoot_;
+    PackFile pack_;
     std::unordered_map<std::type_index, std::shared_ptr<IAssetLoader>> assetLoaders_;
 
+    std::array<PathShard, ASSET_SHARD_COUNT> pathShards_;
+    mutable std::array<std::mutex, ASSET_SHARD_COUNT> slotLocks_;
+    // id 0 stands for the invalid id and never gets a slot
+    std::atomic<u32> nextId_{1};
+    std::array<std::atomic<Slot*>, ASSET_SLOT_BLOCK_COUNT> slotBlocks_{};
+    std::mutex slotBlocksMutex_;
+    // orders slots by their last use, for eviction
+    std::atomic<u64> useClock_{0};
+
+    // innermost lock, taken while holding a slot lock
+    mutable std::mutex accountingMutex_;
+    std::unordered_map<std::type_index, size_t> residentBytes_;
+    size_t totalBytes_{0};
+    std::atomic<size_t> memoryBudget_{0};
+    std::mutex evictionMutex_;
+    // newest first, so the next one to evict is at the back
+    std::vector<EvictionCandidate> evictionCandidates_;
+    // stores left before the next scan, after a scan that left the cache over budget
+    u32 evictionScanSkips_{0};
+
+    std::deque<Upload> uploads_;
+    // queued uploads plus the decodes that reserved a place, decoding waits while it is full
+    u32 uploadReservations_{0};
+    bool uploadsCancelled_{false};
+    std::mutex uploadsMutex_;
+    std::condition_variable uploadSpace_;
+    AssetWatcher watcher_;
+
 private:
     AssetManager() = default;
+    ~AssetManager();
     AssetManager(const AssetManager&) = delete;
     AssetManager& operator=(const AssetManager&) = delete;
     AssetManager(AssetManager&&) = delete;
@@ -41,33 +261,26 @@ inline void AssetManager::registerLoader(std::shared_ptr<IAssetLoader> loader) {
 }
 
 template <class T>
-inline auto AssetManager::load(const std::string& assetPath) -> std::shared_ptr<T> {
-    // check if already cached
-    if(auto it = assets_.find(assetPath); it != assets_.end()) {
-        return std::static_pointer_cast<T>(it->second);
-    }
-
-    // find appropriate loader
-    auto loaderIter = assetLoaders_.find(typeid(T));
-    if(loaderIter == assetLoaders_.end()) {
-        ERROR("[ASSET MANAGER]: loader " + std::string(typeid(T).name()) + " not found");
-        return nullptr;
-    }
-
-    auto loader = loaderIter->second;
+inline auto AssetManager::load(AssetId id) -> std::shared_ptr<T> {
+    return std::static_pointer_cast<T>(loadNow(typeid(T), id));
+}
 
-    // validate path
-    auto path = getAssetPath(assetPath);
-    if(!std::filesystem::exists(path)) {
-        ERROR("[ASSET MANAGER] asset path " + path.generic_string() + " does not exist");
-        return nullptr;
-    }
+template <class T>
+inline auto AssetManager::load(const std::string& assetPath) -> std::shared_ptr<T> {
+    return load<T>(intern(assetPath));
+}
 
-    // load asset via loader
-    auto asset = loader->load(*this, path.generic_string());
+template <class T>
+inline auto AssetManager::residentBytes() const -> size_t {
+    return residentBytes(typeid(T));
+}
 
-    // store asset
-    assets_.emplace(assetPath, asset);
+template <class T>
+inline auto AssetManager::loadAsync(AssetId id) -> AssetFuture<T> {
+    return AssetFuture<T>(startLoad(typeid(T), id));
+}
 
-    return std::static_pointer_cast<T>(asset);
+template <class T>
+inline auto AssetManager::loadAsync(const std::string& assetPath) -> AssetFuture<T> {
+    return loadAsync<T>(intern(assetPath));
 }
@@ -0,0 +1,126 @@
+#include "asset_watcher.hpp"
+
+#include <algorithm>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+#include "log.hpp"
+
+#ifdef __linux__
+// editors either write in place or write a temporary file and rename it over the original
+const u32 WATCH_EVENTS = IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE;
+const size_t WATCH_BUFFER_SIZE = 16 * 1024;
+#endif
+
+AssetWatcher::~AssetWatcher() {
+    stop();
+}
+
+#ifdef __linux__
+
+bool AssetWatcher::start(const std::string& root) {
+    stop();
+
+    fd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if(fd_ < 0) {
+        ERROR("[ASSET WATCHER]: failed to init inotify");
+        return false;
+    }
+
+    // inotify is not recursive, every directory needs its own watch
+    root_ = root;
+    watchDirectory(root_);
+    std::error_code error;
+    for(auto& entry : std::filesystem::recursive_directory_iterator(root_, error)) {
+        if(entry.is_directory()) {
+            watchDirectory(entry.path());
+        }
+    }
+
+    INFO(
+        "[ASSET WATCHER]: watching " + std::to_string(directories_.size()) +
+        " directories below " + root);
+    return true;
+}
+
+void AssetWatcher::stop() {
+    if(fd_ >= 0) {
+        close(fd_);
+        fd_ = -1;
+    }
+    directories_.clear();
+}
+
+auto AssetWatcher::poll() -> std::vector<std::string> {
+    std::vector<std::string> changed;
+    if(fd_ < 0) {
+        return changed;
+    }
+
+    alignas(inotify_event) char buffer[WATCH_BUFFER_SIZE];
+    while(true) {
+        ssize_t length = read(fd_, buffer, sizeof(buffer));
+        if(length <= 0) {
+            break;
+        }
+
+        for(ssize_t offset = 0; offset < length;) {
+            auto event = reinterpret_cast<const inotify_event*>(buffer + offset);
+            offset += sizeof(inotify_event) + event->len;
+
+            auto directory = directories_.find(event->wd);
+            if(directory == directories_.end() || event->len == 0) {
+                continue;
+            }
+            auto path = directory->second / event->name;
+
+            if(event->mask & IN_ISDIR) {
+                if(event->mask & (IN_CREATE | IN_MOVED_TO)) {
+                    watchDirectory(root_ / path);
+                }
+                continue;
+            }
+            // created files are reported once they are closed
+            if(event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO)) {
+                changed.push_back(path.generic_string());
+            }
+        }
+    }
+
+    // saving often produces several events for the same file
+    std::ranges::sort(changed);
+    auto duplicates = std::ranges::unique(changed);
+    changed.erase(duplicates.begin(), duplicates.end());
+    return changed;
+}
+
+void AssetWatcher::watchDirectory(const std::filesystem::path& directory) {
+    int wd = inotify_add_watch(fd_, directory.c_str(), WATCH_EVENTS);
+    if(wd < 0) {
+        ERROR("[ASSET WATCHER]: failed to watch " + directory.generic_string());
+        return;
+    }
+    directories_[wd] = std::filesystem::relative(directory, root_).lexically_normal();
+    if(directories_[wd] == ".") {
+        directories_[wd].clear();
+    }
+}
+
+#else
+
+bool AssetWatcher::start(const std::string& root) {
+    INFO("[ASSET WATCHER]: hot reload is only supported on Linux, not watching " + root);
+    return false;
+}
+
+void AssetWatcher::stop() {
+}
+
+auto AssetWatcher::poll() -> std::vector<std::string> {
+    return {};
+}
+
+#endif
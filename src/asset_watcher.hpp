@@ -0,0 +1,34 @@
+#pragma once
+
+#include "utils.hpp"
+
+/// Reports files written below a directory, through inotify on Linux. Other platforms have no
+/// watcher, start fails there and poll never reports anything.
+class AssetWatcher {
+public:
+    AssetWatcher() = default;
+    ~AssetWatcher();
+
+    bool start(const std::string& root);
+    void stop();
+
+    /// Paths relative to the root of the files finished writing since the last poll, each once.
+    /// Never blocks.
+    auto poll() -> std::vector<std::string>;
+
+private:
+#ifdef __linux__
+    void watchDirectory(const std::filesystem::path& directory);
+
+    int fd_ = -1;
+    // watch descriptor to the watched directory, relative to the root
+    std::unordered_map<int, std::filesystem::path> directories_;
+#endif
+    std::filesystem::path root_;
+
+private:
+    AssetWatcher(const AssetWatcher&) = delete;
+    AssetWatcher& operator=(const AssetWatcher&) = delete;
+    AssetWatcher(AssetWatcher&&) = delete;
+    AssetWatcher& operator=(AssetWatcher&&) = delete;
+};
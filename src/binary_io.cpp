@@ -0,0 +1,154 @@
+#include "binary_io.hpp"
+
+#include <bit>
+
+// "CESK", bump the version whenever the layout of any cooked record changes
+const u32 COOKED_MAGIC = 0x4B534543;
+const u32 COOKED_VERSION = 2;
+const u64 FNV_OFFSET_BASIS = 0xCBF29CE484222325;
+const u64 FNV_PRIME = 0x100000001B3;
+
+void BinaryWriter::writeHeader() {
+    writeU32(COOKED_MAGIC);
+    writeU32(COOKED_VERSION);
+}
+
+void BinaryWriter::writeU8(u8 value) {
+    buffer_.push_back(static_cast<char>(value));
+}
+
+void BinaryWriter::writeBool(bool value) {
+    writeU8(value ? 1 : 0);
+}
+
+void BinaryWriter::writeU32(u32 value) {
+    for(u32 i = 0; i < 4; i++) {
+        writeU8(static_cast<u8>(value >> (8 * i)));
+    }
+}
+
+void BinaryWriter::writeU64(u64 value) {
+    writeU32(static_cast<u32>(value));
+    writeU32(static_cast<u32>(value >> 32));
+}
+
+void BinaryWriter::writeF32(f32 value) {
+    writeU32(std::bit_cast<u32>(value));
+}
+
+void BinaryWriter::writeString(const std::string& value) {
+    writeU32(static_cast<u32>(value.size()));
+    buffer_.insert(buffer_.end(), value.begin(), value.end());
+}
+
+void BinaryWriter::writeVec2(const Vec2& value) {
+    writeF32(value.x);
+    writeF32(value.y);
+}
+
+void BinaryWriter::writeRect(const Rect& value) {
+    writeF32(value.x);
+    writeF32(value.y);
+    writeF32(value.w);
+    writeF32(value.h);
+}
+
+void BinaryWriter::writeBytes(std::span<const char> bytes) {
+    buffer_.insert(buffer_.end(), bytes.begin(), bytes.end());
+}
+
+auto BinaryWriter::data() const -> const std::vector<char>& {
+    return buffer_;
+}
+
+BinaryReader::BinaryReader(std::span<const std::byte> data)
+    : data_(reinterpret_cast<const char*>(data.data()), data.size()), offset_(0), ok_(true) {
+}
+
+bool BinaryReader::readHeader() {
+    u32 magic = readU32();
+    u32 version = readU32();
+    return ok_ && magic == COOKED_MAGIC && version == COOKED_VERSION;
+}
+
+auto BinaryReader::readU8() -> u8 {
+    auto bytes = take(1);
+    return bytes ? static_cast<u8>(bytes[0]) : 0;
+}
+
+bool BinaryReader::readBool() {
+    return readU8() != 0;
+}
+
+auto BinaryReader::readU32() -> u32 {
+    auto bytes = take(4);
+    if(!bytes) {
+        return 0;
+    }
+
+    u32 value = 0;
+    for(u32 i = 0; i < 4; i++) {
+        value |= static_cast<u32>(static_cast<u8>(bytes[i])) << (8 * i);
+    }
+    return value;
+}
+
+auto BinaryReader::readU64() -> u64 {
+    u64 low = readU32();
+    u64 high = readU32();
+    return low | high << 32;
+}
+
+auto BinaryReader::readF32() -> f32 {
+    return std::bit_cast<f32>(readU32());
+}
+
+auto BinaryReader::readString() -> std::string {
+    u32 size = readU32();
+    auto bytes = take(size);
+    return bytes ? std::string(bytes, size) : std::string();
+}
+
+auto BinaryReader::readVec2() -> Vec2 {
+    Vec2 value;
+    value.x = readF32();
+    value.y = readF32();
+    return value;
+}
+
+auto BinaryReader::readRect() -> Rect {
+    Rect value;
+    value.x = readF32();
+    value.y = readF32();
+    value.w = readF32();
+    value.h = readF32();
+    return value;
+}
+
+auto BinaryReader::readBytes(u32 size) -> std::span<const char> {
+    auto bytes = take(size);
+    return bytes ? std::span<const char>(bytes, size) : std::span<const char>();
+}
+
+bool BinaryReader::ok() const {
+    return ok_;
+}
+
+auto BinaryReader::take(u32 size) -> const char* {
+    if(!ok_ || data_.size() - offset_ < size) {
+        ok_ = false;
+        return nullptr;
+    }
+    const char* bytes = data_.data() + offset_;
+    offset_ += size;
+    return bytes;
+}
+
+auto hashBytes(std::span<const char> bytes) -> u64 {
+    u64 hash = FNV_OFFSET_BASIS;
+    for(char byte : bytes) {
+        hash ^= static_cast<u8>(byte);
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
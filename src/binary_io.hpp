@@ -0,0 +1,73 @@
+#pragma once
+
+#include "math.hpp"
+#include "utils.hpp"
+
+/// Builds the binary records of cooked assets. Values are always stored little endian, so blobs
+/// cooked on one machine load on any other.
+class BinaryWriter {
+public:
+    /// Magic and format version, the first thing in every cooked blob.
+    void writeHeader();
+
+    void writeU8(u8 value);
+    void writeBool(bool value);
+    void writeU32(u32 value);
+    void writeU64(u64 value);
+    void writeF32(f32 value);
+    void writeString(const std::string& value);
+    void writeVec2(const Vec2& value);
+    void writeRect(const Rect& value);
+    void writeBytes(std::span<const char> bytes);
+
+    template <class E>
+    void writeEnum(E value) {
+        writeU32(static_cast<u32>(value));
+    }
+
+    auto data() const -> const std::vector<char>&;
+
+private:
+    std::vector<char> buffer_;
+};
+
+/// Reads what BinaryWriter wrote, in place, the data usually is a loaded file or an entry of the
+/// mapped pack. Reading past the end fails the reader instead of throwing, further reads return
+/// zeroes, so parsers check ok() once at the end.
+class BinaryReader {
+public:
+    explicit BinaryReader(std::span<const std::byte> data);
+
+    /// False for anything not cooked with the current format version.
+    bool readHeader();
+
+    auto readU8() -> u8;
+    bool readBool();
+    auto readU32() -> u32;
+    auto readU64() -> u64;
+    auto readF32() -> f32;
+    auto readString() -> std::string;
+    auto readVec2() -> Vec2;
+    auto readRect() -> Rect;
+    /// Points into the reader's data, valid as long as that is.
+    auto readBytes(u32 size) -> std::span<const char>;
+
+    template <class E>
+    auto readEnum() -> E {
+        return static_cast<E>(readU32());
+    }
+
+    bool ok() const;
+
+private:
+    auto take(u32 size) -> const char*;
+
+private:
+    std::span<const char> data_;
+    size_t offset_;
+    bool ok_;
+};
+
+/// 64 bit FNV-1a of the bytes, identifies file contents. Not meant to withstand deliberate
+/// collisions.
+auto hashBytes(std::span<const char> bytes) -> u64;
@@ -0,0 +1,56 @@
+#include "camera.hpp"
+
+#include <algorithm>
+
+// keeps screenToWorld finite
+const f32 MIN_CAMERA_ZOOM = 0.01f;
+
+void Camera::setPosition(const Vec2& position) {
+    position_ = position;
+}
+
+void Camera::centerOn(const Vec2& point) {
+    position_.x = point.x - viewport_.w / (2.0f * zoom_);
+    position_.y = point.y - viewport_.h / (2.0f * zoom_);
+}
+
+void Camera::setZoom(f32 zoom) {
+    zoom_ = std::max(zoom, MIN_CAMERA_ZOOM);
+}
+
+void Camera::setViewport(const Rect& viewport) {
+    viewport_ = viewport;
+}
+
+auto Camera::position() const -> Vec2 {
+    return position_;
+}
+
+auto Camera::zoom() const -> f32 {
+    return zoom_;
+}
+
+auto Camera::viewport() const -> Rect {
+    return viewport_;
+}
+
+auto Camera::worldToScreen(const Vec2& point) const -> Vec2 {
+    return {
+        (point.x - position_.x) * zoom_ + viewport_.x,
+        (point.y - position_.y) * zoom_ + viewport_.y};
+}
+
+auto Camera::worldToScreen(const Rect& rect) const -> Rect {
+    Vec2 topLeft = worldToScreen(Vec2{rect.x, rect.y});
+    return {topLeft.x, topLeft.y, rect.w * zoom_, rect.h * zoom_};
+}
+
+auto Camera::screenToWorld(const Vec2& point) const -> Vec2 {
+    return {
+        (point.x - viewport_.x) / zoom_ + position_.x,
+        (point.y - viewport_.y) / zoom_ + position_.y};
+}
+
+auto Camera::visibleArea() const -> Rect {
+    return {position_.x, position_.y, viewport_.w / zoom_, viewport_.h / zoom_};
+}
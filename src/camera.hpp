@@ -0,0 +1,28 @@
+#pragma once
+
+#include "math.hpp"
+
+/// Maps world coordinates onto the render output. position() is the world point shown at the
+/// top left corner of the viewport, so the default camera keeps world and screen coordinates equal.
+class Camera {
+public:
+    void setPosition(const Vec2& position);
+    void centerOn(const Vec2& point);
+    void setZoom(f32 zoom);
+    void setViewport(const Rect& viewport);
+
+    auto position() const -> Vec2;
+    auto zoom() const -> f32;
+    auto viewport() const -> Rect;
+
+    auto worldToScreen(const Vec2& point) const -> Vec2;
+    auto worldToScreen(const Rect& rect) const -> Rect;
+    auto screenToWorld(const Vec2& point) const -> Vec2;
+    /// The part of the world covered by the viewport.
+    auto visibleArea() const -> Rect;
+
+private:
+    Vec2 position_{0.0f, 0.0f};
+    f32 zoom_{1.0f};
+    Rect viewport_{0.0f, 0.0f, 0.0f, 0.0f};
+};
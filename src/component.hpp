@@ -4,6 +4,8 @@
 
 #include "utils.hpp"
 
+class BinaryReader;
+class BinaryWriter;
 class Renderer;
 class ComponentBase {
 public:
@@ -30,6 +32,14 @@ public:
         return 0;
     }
 
+    /// Writes what changed since the entity was created from its prefab, for entities streamed
+    /// out with their world chunk. Recreating the entity restores the rest.
+    virtual void saveState(BinaryWriter& writer) const {
+    }
+    /// Reads what saveState wrote, once the recreated entity is attached.
+    virtual void loadState(BinaryReader& reader) {
+    }
+
 private:
     friend struct EntityStructureModifier;
 
@@ -50,18 +50,24 @@ void AIComponent::render(std::shared_ptr<Renderer> renderer) {
     auto geometryComponent = entity()->component<GeometryComponent>();
     if(geometryComponent) {
         auto t = combatEntryCooldown_ / COMBAT_ENTRY_COOLDOWN;
-        Rect rect = geometryComponent->rect();
+        Rect combatCooldownBar = geometryComponent->rect();
+        combatCooldownBar.y -= 15;
+        combatCooldownBar.h = 5;
 
-        Rect maxCombatCooldown = rect;
-        maxCombatCooldown.y -= 15;
-        maxCombatCooldown.h = 5;
-
-        Rect currentCombatCooldown;
-        currentCombatCooldown = maxCombatCooldown;
-        currentCombatCooldown.w *= t;
+        renderer->queueOverlayBar(combatCooldownBar, t, {32, 32, 0, 255}, {128, 128, 0, 255});
+    }
 
-        renderer->queueRenderFilledRect(Strata::UI, maxCombatCooldown, 32, 32, 0, 255);
-        renderer->queueRenderFilledRect(Strata::UI, currentCombatCooldown, 128, 128, 0, 255);
+    // aggro range, and the range the target is lost at while fighting
+    Vec2 position = entity()->transform().position;
+    if(isInMode(AIMode::COMBAT)) {
+        f32 lossRadius = aggroRadius_ * AGGRO_LOSS_MULTIPLAYER;
+        renderer->queueDebugCircle({position.x, position.y, aggroRadius_}, 255, 128, 0);
+        renderer->queueDebugCircle({position.x, position.y, lossRadius}, 128, 64, 0);
+        if(auto target = target_.lock()) {
+            renderer->queueDebugLine({position, target->transform().position}, 255, 0, 0);
+        }
+    } else {
+        renderer->queueDebugCircle({position.x, position.y, aggroRadius_}, 255, 255, 0);
     }
 #endif
 }
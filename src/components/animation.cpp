@@ -25,6 +25,16 @@ void AnimationComponent::attach() {
         playAnimation(queuedAnimation_);
         queuedAnimation_ = "";
     }
+
+    reloadListenerId_ = AssetManager::get()->onReloaded.subscribe(
+        [this](AssetId id, IAssetPtr previous, IAssetPtr fresh) { swapReloaded(previous, fresh); });
+}
+
+void AnimationComponent::detach() {
+    if(reloadListenerId_ != SIZE_MAX) {
+        AssetManager::get()->onReloaded.unsubscribe(reloadListenerId_);
+        reloadListenerId_ = SIZE_MAX;
+    }
 }
 
 void AnimationComponent::addAnimationFiles(
@@ -108,6 +118,24 @@ u32 AnimationComponent::index() const {
     return index_;
 }
 
+void AnimationComponent::swapReloaded(const IAssetPtr& previous, const IAssetPtr& fresh) {
+    for(auto& [name, animation] : animations_) {
+        if(animation == previous) {
+            animation = std::static_pointer_cast<AnimationData>(fresh);
+        }
+    }
+
+    // the playing animation continues with the new frames
+    if(currentAnimation_.lock() == previous) {
+        auto animation = std::static_pointer_cast<AnimationData>(fresh);
+        currentAnimation_ = animation;
+        index_ = animation->index;
+        if(currentFrame_ >= animation->frameCount) {
+            currentFrame_ = 0;
+        }
+    }
+}
+
 void AnimationComponent::reset() {
     currentFrame_ = 0;
     currentFrameDuration_ = 0.0f;
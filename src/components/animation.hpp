@@ -17,6 +17,7 @@ class AnimationComponent : public Component<AnimationComponent> {
 public:
     AnimationComponent();
     void attach() override;
+    void detach() override;
     void addAnimationFiles(const std::unordered_map<std::string, std::string>& animationFiles);
     void queueAnimation(const std::string& name);
     void playAnimation(const std::string& name);
@@ -28,6 +29,7 @@ public:
 
 private:
     void reset();
+    void swapReloaded(const IAssetPtr& previous, const IAssetPtr& fresh);
 
 private:
     std::weak_ptr<AnimationData> currentAnimation_;
@@ -39,4 +41,5 @@ private:
     std::function<void()> onAnimationEnd_;
     std::unordered_map<std::string, std::string> animationFiles_;
     std::unordered_map<std::string, std::shared_ptr<AnimationData>> animations_;
+    size_t reloadListenerId_{SIZE_MAX};
 };
\ No newline at end of file
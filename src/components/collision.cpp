@@ -49,23 +49,14 @@ void CollisionSystem::render(std::shared_ptr<Renderer> renderer) {
             auto collider = weakCol.lock();
             auto collided = collisions_.contains(collider.get());
 
+            u8 red = collided ? 255 : 0;
             std::visit(
                 overloaded{
-                    [&](const Rect& debugRect) {
-                        if(collided) {
-                            renderer->queueRenderRect(Strata::DEB, debugRect, 255, 0, 0, 255);
-                        } else {
-                            renderer->queueRenderRect(Strata::DEB, debugRect);
-                        }
+                    [&](const Rect& debugRect) { renderer->queueDebugRect(debugRect, red, 0, 0); },
+                    [&](const Line& debugLine) { renderer->queueDebugLine(debugLine, red, 0, 0); },
+                    [&](const Circle& debugCircle) {
+                        renderer->queueDebugCircle(debugCircle, red, 0, 0);
                     },
-                    [&](const Line& debugLine) {
-                        if(collided) {
-                            renderer->queueRenderLine(Strata::DEB, debugLine, 255, 0, 0, 255);
-                        } else {
-                            renderer->queueRenderLine(Strata::DEB, debugLine);
-                        }
-                    },
-                    [&](const Circle& debugCircle) {},
                 },
                 collider->shape());
         }
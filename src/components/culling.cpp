@@ -0,0 +1,52 @@
+#include "culling.hpp"
+
+#include "../renderer.hpp"
+#include "geometry.hpp"
+#include "particle_system.hpp"
+
+// life bars and particles reach past the sprite or particle position itself
+const f32 CULLING_MARGIN = 64.0f;
+
+void CullingSystem::render(std::shared_ptr<Renderer> renderer) {
+    Rect area = renderer->camera().visibleArea();
+    area.x -= CULLING_MARGIN;
+    area.y -= CULLING_MARGIN;
+    area.w += 2.0f * CULLING_MARGIN;
+    area.h += 2.0f * CULLING_MARGIN;
+
+    queryResult_.clear();
+    GeometryComponent::spatialIndex().query(area, queryResult_);
+
+    // only entities that were visible last frame need to be hidden again, so the cost follows the
+    // number of entities on screen rather than the size of the world
+    for(auto& weakEntity : visible_) {
+        if(auto entity = weakEntity.lock()) {
+            entity->setCulled(true);
+        }
+    }
+
+    nextVisible_.clear();
+    for(auto geometry : queryResult_) {
+        if(auto entity = geometry->entity()) {
+            entity->setCulled(false);
+            nextVisible_.push_back(entity);
+        }
+    }
+
+    // Particles drift away from their emitter, which stays visible while any of them is on
+    // screen. Unlike the rest this walks every emitter, on screen or not.
+    for(auto& weakComponent : ParticleSystemComponent::trackedComponents()) {
+        auto component = weakComponent.lock();
+        auto entity = component ? component->entity() : nullptr;
+        if(!entity || !entity->isCulled()) {
+            continue;
+        }
+        auto bounds = component->particleBounds();
+        if(bounds && bounds->x <= area.x + area.w && bounds->x + bounds->w >= area.x &&
+           bounds->y <= area.y + area.h && bounds->y + bounds->h >= area.y) {
+            entity->setCulled(false);
+            nextVisible_.push_back(entity);
+        }
+    }
+    std::swap(visible_, nextVisible_);
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+#include "../component.hpp"
+#include "../entity.hpp"
+#include "../spatial_grid.hpp"
+
+/// Marks the entities whose geometry lies outside the camera as culled before the scene renders,
+/// so off-screen sprites, bars and effects are never queued. Entities whose particles are still on
+/// screen stay visible. Has to live on the root entity.
+class CullingSystem : public Component<CullingSystem> {
+public:
+    void render(std::shared_ptr<Renderer> renderer) override;
+
+private:
+    std::vector<EntityHandle> visible_;
+    std::vector<EntityHandle> nextVisible_;
+    std::vector<SpatialGrid::Item> queryResult_;
+};
@@ -4,8 +4,16 @@
 #include "../renderer.hpp"
 #include "animation.hpp"
 
+const f32 SPATIAL_INDEX_CELL_SIZE = 256.0f;
+
+auto GeometryComponent::spatialIndex() -> SpatialGrid& {
+    static SpatialGrid index(SPATIAL_INDEX_CELL_SIZE);
+    return index;
+}
+
 void GeometryComponent::setTextureFilePath(const std::string& filePath) {
     textureFilePath_ = filePath;
+    texture_ = TextureRegistry::get().acquire(filePath);
 }
 
 void GeometryComponent::setGeometryData(const GeometryData& geometryData) {
@@ -13,10 +21,18 @@ void GeometryComponent::setGeometryData(const GeometryData& geometryData) {
     rect_ = geometryData_.rect;
 }
 
+void GeometryComponent::onAttach() {
+    updateRect();
+    // hidden until the culling pass finds it on screen
+    entity()->setCulled(true);
+}
+
+void GeometryComponent::onDetach() {
+    spatialIndex().remove(this);
+}
+
 void GeometryComponent::postUpdate(f32 dt) {
-    Transform transform = entity()->transform();
-    rect_.x = transform.position.x + geometryData_.rect.x;
-    rect_.y = transform.position.y + geometryData_.rect.y;
+    updateRect();
 }
 
 void GeometryComponent::render(std::shared_ptr<Renderer> renderer) {
@@ -30,19 +46,38 @@ void GeometryComponent::render(std::shared_ptr<Renderer> renderer) {
         sRect.y = animationComponent->index() * rect_.h;
     }
 
-    Vec2 rotationPoint;
-    if(rect_.w > rect_.h) {
-        rotationPoint = {0.0f, dRect.h / 2.0f};
-    } else if(rect_.w < rect_.h) {
-        rotationPoint = {dRect.w / 2.0f, 0.0f};
-    } else {
-        rotationPoint = {dRect.w / 2.0f, dRect.h / 2.0f};
-    }
-
     renderer->queueRenderTextureRotated(
-        Strata::ENTITY, textureFilePath_, sRect, dRect, rotationPoint, transform.rotation);
+        Strata::ENTITY, texture_, sRect, dRect, rotationPoint(), transform.rotation);
 }
 
 Rect GeometryComponent::rect() const {
     return rect_;
 }
+
+void GeometryComponent::updateRect() {
+    Transform transform = entity()->transform();
+    rect_.x = transform.position.x + geometryData_.rect.x;
+    rect_.y = transform.position.y + geometryData_.rect.y;
+
+    spatialIndex().update(this, bounds(transform.rotation));
+}
+
+auto GeometryComponent::rotationPoint() const -> Vec2 {
+    if(rect_.w > rect_.h) {
+        return {0.0f, rect_.h / 2.0f};
+    } else if(rect_.w < rect_.h) {
+        return {rect_.w / 2.0f, 0.0f};
+    }
+    return {rect_.w / 2.0f, rect_.h / 2.0f};
+}
+
+auto GeometryComponent::bounds(f32 rotation) const -> Rect {
+    if(rotation == 0.0f) {
+        return rect_;
+    }
+
+    // any rotation of the sprite stays within its diagonal around the pivot
+    Vec2 pivot = rotationPoint();
+    f32 reach = sqrtf(rect_.w * rect_.w + rect_.h * rect_.h);
+    return {rect_.x + pivot.x - reach, rect_.y + pivot.y - reach, 2.0f * reach, 2.0f * reach};
+}
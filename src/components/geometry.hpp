@@ -4,6 +4,8 @@
 
 #include "../component.hpp"
 #include "../math.hpp"
+#include "../spatial_grid.hpp"
+#include "../texture_registry.hpp"
 #include "../utils.hpp"
 
 enum class GeometrySizeDeterminant { TARGET, NONE };
@@ -13,8 +15,11 @@ struct GeometryData {
     GeometrySizeDeterminant sizeDeterminant;
 };
 
-class GeometryComponent : public Component<GeometryComponent> {
+class GeometryComponent : public TrackedComponent<GeometryComponent> {
 public:
+    /// Every attached geometry, keyed by the area its sprite can cover.
+    static auto spatialIndex() -> SpatialGrid&;
+
     s32 updatePriority() override {
         return 3;
     }
@@ -24,8 +29,18 @@ public:
     void render(std::shared_ptr<Renderer> renderer) override;
     Rect rect() const;
 
+protected:
+    void onAttach() override;
+    void onDetach() override;
+
+private:
+    void updateRect();
+    auto rotationPoint() const -> Vec2;
+    auto bounds(f32 rotation) const -> Rect;
+
 private:
     std::string textureFilePath_;
+    TextureHandle texture_;
     Rect rect_;
     GeometryData geometryData_;
 };
@@ -1,5 +1,6 @@
 #include "life.hpp"
 
+#include "../binary_io.hpp"
 #include "../entity.hpp"
 #include "../renderer.hpp"
 #include "geometry.hpp"
@@ -35,6 +36,18 @@ void LifeComponent::reset() {
     }
 }
 
+void LifeComponent::saveState(BinaryWriter& writer) const {
+    writer.writeF32(life_.current);
+}
+
+void LifeComponent::loadState(BinaryReader& reader) {
+    // the maximum follows the level again, a reader that ran out leaves the full value
+    f32 current = reader.readF32();
+    if(reader.ok()) {
+        life_.current = std::min(current, life_.max);
+    }
+}
+
 void LifeComponent::reduceLife(f32 amount, EntityPtr applier) {
     life_.current -= std::clamp(amount, 0.0f, life_.current);
     lastAttacker_ = applier;
@@ -98,18 +111,11 @@ void LifeComponent::render(std::shared_ptr<Renderer> renderer) {
     auto geometryComponent = entity()->component<GeometryComponent>();
     if(geometryComponent) {
         auto t = life_.current / life_.max;
-        Rect rect = geometryComponent->rect();
-
-        Rect missingLifeBar = rect;
-        missingLifeBar.y -= LIFE_BAR_VERTICAL_OFFSET;
-        missingLifeBar.h = LIFE_BAR_HEIGHT;
-
-        Rect currentLifeBar;
-        currentLifeBar = missingLifeBar;
-        currentLifeBar.w *= t;
+        Rect lifeBar = geometryComponent->rect();
+        lifeBar.y -= LIFE_BAR_VERTICAL_OFFSET;
+        lifeBar.h = LIFE_BAR_HEIGHT;
 
-        renderer->queueRenderFilledRect(Strata::UI, missingLifeBar, 32, 0, 0, 255);
-        renderer->queueRenderFilledRect(Strata::UI, currentLifeBar, 128, 0, 0, 255);
+        renderer->queueOverlayBar(lifeBar, t, {32, 0, 0, 255}, {128, 0, 0, 255});
     }
 }
 
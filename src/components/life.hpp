@@ -22,6 +22,8 @@ public:
     void update(const f32 dt) override;
     void postUpdate(const f32 dt) override;
     void render(std::shared_ptr<Renderer> renderer) override;
+    void saveState(BinaryWriter& writer) const override;
+    void loadState(BinaryReader& reader) override;
 
 private:
     void regen(const f32 dt);
@@ -1,9 +1,15 @@
 #include "mana.hpp"
 
+#include "../binary_io.hpp"
 #include "../entity.hpp"
+#include "../renderer.hpp"
+#include "geometry.hpp"
 #include "xp.hpp"
 
 const f32 MANA_PER_LEVEL_INCREMENT = 5.0f;
+// right below the life bar
+const f32 MANA_BAR_VERTICAL_OFFSET = 5;
+const f32 MANA_BAR_HEIGHT = 5;
 
 ManaComponent::ManaComponent() : mana_{0.0f, 0.0f} {
 }
@@ -29,6 +35,17 @@ void ManaComponent::reset() {
     }
 }
 
+void ManaComponent::saveState(BinaryWriter& writer) const {
+    writer.writeF32(mana_.current);
+}
+
+void ManaComponent::loadState(BinaryReader& reader) {
+    f32 current = reader.readF32();
+    if(reader.ok()) {
+        mana_.current = std::min(current, mana_.max);
+    }
+}
+
 void ManaComponent::reduceMana(u32 amount) {
     mana_.current -= std::clamp(static_cast<f32>(amount), 0.0f, mana_.current);
 }
@@ -50,6 +67,18 @@ void ManaComponent::postUpdate(const f32 dt) {
     }
 }
 
+void ManaComponent::render(std::shared_ptr<Renderer> renderer) {
+    auto geometryComponent = entity()->component<GeometryComponent>();
+    if(geometryComponent && mana_.max > 0.0f) {
+        Rect manaBar = geometryComponent->rect();
+        manaBar.y -= MANA_BAR_VERTICAL_OFFSET;
+        manaBar.h = MANA_BAR_HEIGHT;
+
+        renderer->queueOverlayBar(
+            manaBar, mana_.current / mana_.max, {0, 0, 32, 255}, {0, 64, 160, 255});
+    }
+}
+
 void ManaComponent::regen(const f32 dt) {
     mana_.current += mana_.regen * dt;
 }
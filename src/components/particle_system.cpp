@@ -6,47 +6,67 @@
 #include "../entity.hpp"
 #include "../math.hpp"
 #include "../renderer.hpp"
+#include "../thread_pool.hpp"
 
-void Emitter::setData(std::shared_ptr<EmitterData> emitterData) {
+// emitters simulated by a single job, each job owns one random stream
+const u32 EMITTERS_PER_BATCH = 8;
+
+namespace {
+    // splitmix64 finalizer, spreads neighbouring tick/batch pairs into unrelated seeds
+    u64 mixSeed(u64 value) {
+        value += 0x9e3779b97f4a7c15ull;
+        value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ull;
+        value = (value ^ (value >> 27)) * 0x94d049bb133111ebull;
+        return value ^ (value >> 31);
+    }
+
+    // the smallest rect covering both
+    Rect unite(const Rect& a, const Rect& b) {
+        f32 x = std::min(a.x, b.x);
+        f32 y = std::min(a.y, b.y);
+        return {x, y, std::max(a.x + a.w, b.x + b.w) - x, std::max(a.y + a.h, b.y + b.h) - y};
+    }
+}  // namespace
+
+// particle data is resolved up front, the simulation runs off the main thread and must not touch
+// the asset manager
+void Emitter::setData(
+    std::shared_ptr<EmitterData> emitterData, std::shared_ptr<ParticleData> particleData) {
     emitterData_ = emitterData;
+    particleData_ = particleData;
+    texture_ = TextureRegistry::get().acquire(particleData_->textureFilePath);
 }
 
-void Emitter::spawnParticle(Transform entityTransform) {
-    auto am = AssetManager::get();
-    auto particleData = am->load<ParticleData>(emitterData_->particleDataFile);
-    if(!particleData) {
-        ERROR_ONCE("[EMITTER]: failed to acquire particle data");
-        return;
-    }
+void Emitter::spawnParticle(const Transform& entityTransform, RandomNumberGenerator& rng) {
     Particle particle;
-    particle.textureFilePath = particleData->textureFilePath;
+    particle.texture = texture_;
     particle.position = entityTransform.position;
-    particle.startAlpha = rng_.getFloat(particleData->minStartAlpha, particleData->maxStartAlpha);
+    particle.startAlpha = rng.getFloat(particleData_->minStartAlpha, particleData_->maxStartAlpha);
     particle.currentAlpha = particle.startAlpha;
 
-    particle.finalAlpha = rng_.getFloat(particleData->minEndAlpha, particleData->maxEndAlpha);
+    particle.finalAlpha = rng.getFloat(particleData_->minEndAlpha, particleData_->maxEndAlpha);
 
     particle.angle = entityTransform.rotation + emitterData_->directionAngle;
     particle.angle = particle.angle > std::numbers::pi_v<f32> * 2
                          ? particle.angle - std::numbers::pi_v<f32> * 2
                          : particle.angle;
 
-    particle.speed = rng_.getFloat(particleData->minSpeed, particleData->maxSpeed);
-    particle.startScale = rng_.getFloat(particleData->minStartScale, particleData->maxStartScale);
+    particle.speed = rng.getFloat(particleData_->minSpeed, particleData_->maxSpeed);
+    particle.startScale = rng.getFloat(particleData_->minStartScale, particleData_->maxStartScale);
 
     particle.currentScale = particle.startScale;
 
-    particle.finalScale = rng_.getFloat(particleData->minEndScale, particleData->maxEndScale);
+    particle.finalScale = rng.getFloat(particleData_->minEndScale, particleData_->maxEndScale);
 
-    particle.startDuration = rng_.getFloat(particleData->minLifeTime, particleData->maxLifeTime);
+    particle.startDuration = rng.getFloat(particleData_->minLifeTime, particleData_->maxLifeTime);
     particle.currentDuration = particle.startDuration;
 
-    particle.maxDuration = particleData->maxLifeTime;
+    particle.maxDuration = particleData_->maxLifeTime;
     particle.angularVelocity =
-        rng_.getFloat(particleData->minAngularVelocity, particleData->maxAngularVelocity);
+        rng.getFloat(particleData_->minAngularVelocity, particleData_->maxAngularVelocity);
 
     if(emitterData_->shape == EmitterShape::ARC) {
-        f32 angleVariance = rng_.getFloat(-emitterData_->arc / 2.0f, emitterData_->arc / 2.0f);
+        f32 angleVariance = rng.getFloat(-emitterData_->arc / 2.0f, emitterData_->arc / 2.0f);
         particle.angle += angleVariance;
     }
 
@@ -64,6 +84,42 @@ void Emitter::spawnParticle(Transform entityTransform) {
     }
 }
 
+void Emitter::simulate(
+    const Transform& entityTransform, bool emitting, const f32 dt, RandomNumberGenerator& rng) {
+    // is time to spawn? are we active?
+    if(canSpawn() && emitting) {
+        spawnParticle(entityTransform, rng);
+    }
+    for(auto& particle : particles_) {
+        if(!particle.dead) {
+            particle.previousPosition = particle.position;
+            particle.previousAngle = particle.angle;
+            particle.position += particle.velocity * particle.speed * dt;
+            if(particle.currentDuration < particle.maxDuration) {
+                f32 t = math::rlerp(
+                    particle.startDuration, particle.maxDuration, particle.currentDuration);
+                particle.currentScale = math::lerp(particle.startScale, particle.finalScale, t);
+                particle.currentAlpha = math::lerp(particle.startAlpha, particle.finalAlpha, t);
+                particle.angle += particle.angularVelocity * dt;
+                particle.currentDuration += dt;
+            }
+            if(particle.currentDuration > particle.maxDuration) {
+                particle.dead = true;
+            }
+        }
+        updateSpawnTime(dt);
+    }
+
+    // for culling, an emitter off screen may still have particles on it
+    bounds_ = std::nullopt;
+    for(auto& particle : particles_) {
+        if(!particle.dead) {
+            Rect point = {particle.position.x, particle.position.y, 0.0f, 0.0f};
+            bounds_ = bounds_ ? unite(*bounds_, point) : point;
+        }
+    }
+}
+
 auto Emitter::particles() -> std::vector<Particle>& {
     return particles_;
 }
@@ -72,6 +128,10 @@ void Emitter::updateSpawnTime(const f32 dt) {
     spawnTime_ += dt;
 }
 
+auto Emitter::bounds() const -> std::optional<Rect> {
+    return bounds_;
+}
+
 bool Emitter::canSpawn() {
     if(spawnTime_ > cooldown()) {
         return true;
@@ -83,16 +143,53 @@ f32 Emitter::cooldown() {
     return 1.0f / emitterData_->spawnRate;
 }
 
-void ParticleSystemComponent::attach() {
+void ParticleSystemComponent::onAttach() {
     auto am = AssetManager::get();
     for(auto& ef : emitterFilePaths_) {
-        auto emitterData = am->load<EmitterData>(ef);
-        if(emitterData) {
-            Emitter emitter;
-            emitter.setData(emitterData);
-            emitter.particles().resize(emitterData->maxParticles);
-            emitters_.push_back(emitter);
+        pendingEmitters_.push_back({ef, am->loadAsync<EmitterData>(ef), {}});
+    }
+    // cached emitters start right away
+    addLoadedEmitters();
+}
+
+void ParticleSystemComponent::update(const f32 dt) {
+    addLoadedEmitters();
+}
+
+void ParticleSystemComponent::addLoadedEmitters() {
+    auto am = AssetManager::get();
+    for(auto it = pendingEmitters_.begin(); it != pendingEmitters_.end();) {
+        if(!it->emitterData.ready()) {
+            ++it;
+            continue;
         }
+        auto emitterData = it->emitterData.get();
+        if(!emitterData) {
+            it = pendingEmitters_.erase(it);
+            continue;
+        }
+
+        if(!it->particleData.valid()) {
+            it->particleData = am->loadAsync<ParticleData>(emitterData->particleDataFile);
+        }
+        if(!it->particleData.ready()) {
+            ++it;
+            continue;
+        }
+        auto particleData = it->particleData.get();
+        if(!particleData) {
+            ERROR(
+                "[PARTICLE SYSTEM COMPONENT]: failed to acquire particle data for " +
+                it->filePath);
+            it = pendingEmitters_.erase(it);
+            continue;
+        }
+
+        Emitter emitter;
+        emitter.setData(emitterData, particleData);
+        emitter.particles().resize(emitterData->maxParticles);
+        emitters_.push_back(emitter);
+        it = pendingEmitters_.erase(it);
     }
 }
 
@@ -111,40 +208,75 @@ void ParticleSystemComponent::setEmitting(bool state) {
     active_ = state;
 }
 
-void ParticleSystemComponent::update(const f32 dt) {
+bool ParticleSystemComponent::isEmitting() const {
+    return active_;
+}
+
+auto ParticleSystemComponent::emitters() -> std::vector<Emitter>& {
+    return emitters_;
+}
+
+auto ParticleSystemComponent::particleBounds() const -> std::optional<Rect> {
+    std::optional<Rect> bounds;
     for(auto& emitter : emitters_) {
-        // is time to spawn? are we active?
-        if(emitter.canSpawn() && active_) {
-            emitter.spawnParticle(entity()->transform());
-        }
-        for(auto& particle : emitter.particles()) {
-            if(!particle.dead) {
-                particle.position += particle.velocity * particle.speed * dt;
-                if(particle.currentDuration < particle.maxDuration) {
-                    f32 t = math::rlerp(
-                        particle.startDuration, particle.maxDuration, particle.currentDuration);
-                    particle.currentScale = math::lerp(particle.startScale, particle.finalScale, t);
-                    particle.currentAlpha = math::lerp(particle.startAlpha, particle.finalAlpha, t);
-                    particle.angle += particle.angularVelocity * dt;
-                    particle.currentDuration += dt;
-                }
-                if(particle.currentDuration > particle.maxDuration) {
-                    particle.dead = true;
-                }
-            }
-            emitter.updateSpawnTime(dt);
+        if(auto emitterBounds = emitter.bounds()) {
+            bounds = bounds ? unite(*bounds, *emitterBounds) : *emitterBounds;
         }
     }
+    return bounds;
 }
 
 void ParticleSystemComponent::render(std::shared_ptr<Renderer> renderer) {
+    RenderMotion entityMotion = renderer->motion();
     for(auto& emitter : emitters_) {
         for(auto& particle : emitter.particles()) {
             if(!particle.dead) {
+                // particles move on their own, independent of the emitting entity
+                renderer->setMotion(
+                    {particle.position - particle.previousPosition,
+                     particle.angle - particle.previousAngle});
                 renderer->queueRenderTextureRotated(
-                    Strata::EFFECT, particle.textureFilePath, particle.position, particle.angle,
+                    Strata::EFFECT, particle.texture, particle.position, particle.angle,
                     particle.currentScale, particle.currentAlpha);
             }
         }
     }
+    renderer->setMotion(entityMotion);
+}
+
+ParticleSystem::ParticleSystem(u64 seed) : seed_(seed) {
+}
+
+void ParticleSystem::postUpdate(const f32 dt) {
+    // gather on the main thread, workers never touch the entity tree
+    for(auto& weakComponent : ParticleSystemComponent::trackedComponents()) {
+        auto component = weakComponent.lock();
+        if(!component) {
+            continue;
+        }
+        auto e = component->entity();
+        if(!e || !e->isActive()) {
+            continue;
+        }
+        components_.push_back(component);
+        for(auto& emitter : component->emitters()) {
+            jobs_.push_back({&emitter, e->transform(), component->isEmitting()});
+        }
+    }
+
+    u32 batchCount = static_cast<u32>((jobs_.size() + EMITTERS_PER_BATCH - 1) / EMITTERS_PER_BATCH);
+    u64 stepSeed = mixSeed(seed_ ^ mixSeed(step_++));
+
+    ThreadPool::get().parallelFor(batchCount, [&](u32 batch) {
+        RandomNumberGenerator rng(mixSeed(stepSeed + batch));
+        size_t begin = static_cast<size_t>(batch) * EMITTERS_PER_BATCH;
+        size_t end = std::min(begin + EMITTERS_PER_BATCH, jobs_.size());
+        for(size_t i = begin; i < end; i++) {
+            auto& job = jobs_[i];
+            job.emitter->simulate(job.transform, job.emitting, dt, rng);
+        }
+    });
+
+    jobs_.clear();
+    components_.clear();
 }
@@ -1,8 +1,12 @@
 #pragma once
+#include <optional>
+
+#include "../asset_future.hpp"
 #include "../component.hpp"
 #include "../i_asset.hpp"
 #include "../math.hpp"
 #include "../random_number_generator.hpp"
+#include "../texture_registry.hpp"
 
 struct ParticleData : IAsset {
     std::string textureFilePath;
@@ -33,9 +37,12 @@ struct ParticleData : IAsset {
 };
 
 struct Particle {
-    std::string textureFilePath;
+    TextureHandle texture;
     bool dead{true};
     Vec2 position;
+    // state before the last step, for render interpolation
+    Vec2 previousPosition;
+    f32 previousAngle;
     Vec2 velocity;
     f32 maxDuration;
     f32 startDuration;
@@ -64,9 +71,14 @@ struct EmitterData : IAsset {
 
 class Emitter {
 public:
-    void setData(std::shared_ptr<EmitterData> emitterData);
-    void spawnParticle(Transform entityTransform);
+    void setData(
+        std::shared_ptr<EmitterData> emitterData, std::shared_ptr<ParticleData> particleData);
+    void spawnParticle(const Transform& entityTransform, RandomNumberGenerator& rng);
+    void simulate(
+        const Transform& entityTransform, bool emitting, const f32 dt, RandomNumberGenerator& rng);
     auto particles() -> std::vector<Particle>&;
+    /// Spans the positions of the live particles as of the last simulate, nullopt without any.
+    auto bounds() const -> std::optional<Rect>;
     bool canSpawn();
     void updateSpawnTime(const f32 dt);
 
@@ -76,20 +88,62 @@ private:
 private:
     f32 spawnTime_{0};
     std::shared_ptr<EmitterData> emitterData_;
+    std::shared_ptr<ParticleData> particleData_;
+    TextureHandle texture_;
     std::vector<Particle> particles_;
-    RandomNumberGenerator rng_;
+    std::optional<Rect> bounds_;
 };
 
-class ParticleSystemComponent : public Component<ParticleSystemComponent> {
+class ParticleSystemComponent : public TrackedComponent<ParticleSystemComponent> {
 public:
-    void attach() override;
     void addEmitterFiles(const std::vector<std::string>& emitterFilePaths);
     void setEmitting(bool state);
+    bool isEmitting() const;
+    auto emitters() -> std::vector<Emitter>&;
+    /// Where the live particles of all emitters are, they drift away from the entity.
+    auto particleBounds() const -> std::optional<Rect>;
     void update(const f32 dt) override;
     void render(std::shared_ptr<Renderer> renderer) override;
 
+protected:
+    void onAttach() override;
+
+private:
+    // emitter data first, its particle data once the emitter data is known
+    struct PendingEmitter {
+        std::string filePath;
+        AssetFuture<EmitterData> emitterData;
+        AssetFuture<ParticleData> particleData;
+    };
+
+    void addLoadedEmitters();
+
 private:
     bool active_{true};
     std::vector<std::string> emitterFilePaths_;
+    std::vector<PendingEmitter> pendingEmitters_;
     std::vector<Emitter> emitters_;
 };
+
+/// Simulates every particle emitter once per tick, after gameplay movement has settled. Emitters
+/// only read their own entity transform and write their own particles, so they are split into
+/// fixed size batches and spread across the thread pool. Every batch draws from its own random
+/// stream derived from the tick and batch index, keeping the result independent of the worker
+/// count and of scheduling.
+class ParticleSystem : public Component<ParticleSystem> {
+public:
+    explicit ParticleSystem(u64 seed = 0);
+    void postUpdate(const f32 dt) override;
+
+private:
+    struct EmitterJob {
+        Emitter* emitter;
+        Transform transform;
+        bool emitting;
+    };
+
+    std::vector<std::shared_ptr<ParticleSystemComponent>> components_;
+    std::vector<EmitterJob> jobs_;
+    u64 seed_;
+    u64 step_{0};
+};
@@ -17,7 +17,7 @@ void SpawnComponent::attach() {
         return;
     }
     auto am = AssetManager::get();
-    entityData_ = am->load<EntityData>(spawnPrefabFile_);
+    entityData_ = am->loadAsync<EntityData>(spawnPrefabFile_);
 }
 
 void SpawnComponent::setSpawn(const std::string& name, const std::string& prefabFile) {
@@ -25,13 +25,17 @@ void SpawnComponent::setSpawn(const std::string& name, const std::string& prefab
     spawnPrefabFile_ = prefabFile;
 }
 
-void SpawnComponent::spawn(const Vec2& position) const {
+bool SpawnComponent::spawn(const Vec2& position) const {
     if(spawnName_.empty()) {
         ERROR("[SPAWN]: spawnName is empty");
-        return;
+        return true;
     }
 
-    auto ed = entityData_.lock();
+    // normally loaded long before the first spawn, the tick never waits for the disk
+    if(!entityData_.ready()) {
+        return false;
+    }
+    auto ed = entityData_.get();
     if(ed) {
         auto root = std::static_pointer_cast<Scene>(entity()->root());
         auto entity = root->entityCreator().createEntity(spawnName_, ed);
@@ -40,4 +44,5 @@ void SpawnComponent::spawn(const Vec2& position) const {
         entity->setTransform(transform);
         root->addChild(entity);
     }
+    return true;
 }
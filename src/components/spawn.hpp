@@ -1,5 +1,6 @@
 #pragma once
 
+#include "../asset_future.hpp"
 #include "../component.hpp"
 #include "../entity_data.hpp"
 #include "../math.hpp"
@@ -9,10 +10,12 @@ public:
     SpawnComponent();
     void attach() override;
     void setSpawn(const std::string& name, const std::string& prefabFile);
-    void spawn(const Vec2& position) const;
+    /// False while the prefab is still loading, nothing is spawned then and the caller tries again
+    /// on a later tick. Failures count as done, they are logged.
+    bool spawn(const Vec2& position) const;
 
 private:
     std::string spawnName_;
     std::string spawnPrefabFile_;
-    std::weak_ptr<EntityData> entityData_;
+    AssetFuture<EntityData> entityData_;
 };
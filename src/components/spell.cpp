@@ -65,8 +65,8 @@ void SpellComponent::update(f32 dt) {
 
     if(spellData_->action.type == ActionType::SPAWN) {
         auto spawnComponent = entity()->component<SpawnComponent>();
-        if(spawnComponent) {
-            spawnComponent->spawn(oldPosition);
+        // the spell lingers until its prefab is loaded
+        if(spawnComponent && spawnComponent->spawn(oldPosition)) {
             state_ = State::Dying;
         }
     }
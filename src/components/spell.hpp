@@ -1,5 +1,6 @@
 #pragma once
 
+#include "../asset_id.hpp"
 #include "../component.hpp"
 #include "../entity.hpp"
 #include "../i_asset.hpp"
@@ -48,6 +49,8 @@ struct SpellEffect {
     u32 maxStacks{1};
     bool visual;
     std::string effectFilePath{""};
+    // effectFilePath interned, looked up every time the effect is applied
+    AssetId effectAsset;
     EntityHandle applier;
 
     bool isDirect() const;
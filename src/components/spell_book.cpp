@@ -1,8 +1,11 @@
 #include "spell_book.hpp"
 
+#include <algorithm>
+
 #include "../asset_manager.hpp"
 #include "../entity.hpp"
 #include "../log.hpp"
+#include "../renderer.hpp"
 #include "animation.hpp"
 #include "mana.hpp"
 #include "owner.hpp"
@@ -11,18 +14,32 @@
 #include "spell.hpp"
 #include "status_effect.hpp"
 
+// above the life bar and the ai combat cooldown
+const f32 CAST_BAR_VERTICAL_OFFSET = 20;
+const f32 CAST_BAR_HEIGHT = 5;
+
 void SpellBookComponent::attach() {
     auto am = AssetManager::get();
     for(auto& it : spellFiles_) {
-        auto s = am->load<SpellData>(it);
-        if(s) {
-            addSpell(s);
-        }
+        pendingSpells_.push_back(am->loadAsync<SpellData>(it));
+    }
+    // cached spells are ready right away
+    addLoadedSpells();
+
+    reloadListenerId_ = am->onReloaded.subscribe(
+        [this](AssetId id, IAssetPtr previous, IAssetPtr fresh) { swapReloaded(previous, fresh); });
+}
+
+void SpellBookComponent::detach() {
+    if(reloadListenerId_ != SIZE_MAX) {
+        AssetManager::get()->onReloaded.unsubscribe(reloadListenerId_);
+        reloadListenerId_ = SIZE_MAX;
     }
-    autoEquipSpells();
 }
 
 void SpellBookComponent::update(f32 dt) {
+    addLoadedSpells();
+
     // update cooldowns
     for(auto&& cd : cooldowns_) {
         cd.second -= dt;
@@ -134,6 +151,17 @@ void SpellBookComponent::update(f32 dt) {
     }
 }
 
+void SpellBookComponent::render(std::shared_ptr<Renderer> renderer) {
+    auto geometryComponent = entity()->component<GeometryComponent>();
+    if(geometryComponent && castedSpell_) {
+        Rect castBar = geometryComponent->rect();
+        castBar.y -= CAST_BAR_VERTICAL_OFFSET;
+        castBar.h = CAST_BAR_HEIGHT;
+
+        renderer->queueOverlayBar(castBar, castProgress_, {32, 32, 32, 255}, {192, 160, 0, 255});
+    }
+}
+
 void SpellBookComponent::addSpell(const std::shared_ptr<SpellData> spellData) {
     spells_.push_back(spellData);
 }
@@ -268,6 +296,25 @@ u32 SpellBookComponent::availableSpellsCount() const {
     return static_cast<u32>(spells_.size());
 }
 
+void SpellBookComponent::addLoadedSpells() {
+    if(pendingSpells_.empty()) {
+        return;
+    }
+    for(auto& pending : pendingSpells_) {
+        if(!pending.ready()) {
+            return;
+        }
+    }
+
+    for(auto& pending : pendingSpells_) {
+        if(auto s = pending.get()) {
+            addSpell(s);
+        }
+    }
+    pendingSpells_.clear();
+    autoEquipSpells();
+}
+
 void SpellBookComponent::autoEquipSpells() {
     for(u32 j = 0; j < spellSlots_.size(); j++) {
         for(u32 i = j; i < spells_.size();) {
@@ -343,3 +390,22 @@ auto SpellBookComponent::determineCollision() -> CollisionData {
     }
     return collisionData;
 }
+
+void SpellBookComponent::swapReloaded(const IAssetPtr& previous, const IAssetPtr& fresh) {
+    auto old = std::dynamic_pointer_cast<SpellData>(previous);
+    if(!old) {
+        return;
+    }
+    auto spell = std::static_pointer_cast<SpellData>(fresh);
+    std::ranges::replace(spells_, old, spell);
+    std::ranges::replace(spellSlots_, old, spell);
+    if(castedSpell_ == old) {
+        castedSpell_ = spell;
+    }
+    // a running cooldown carries over
+    if(auto cooldown = cooldowns_.find(old); cooldown != cooldowns_.end()) {
+        f32 remaining = cooldown->second;
+        cooldowns_.erase(cooldown);
+        cooldowns_[spell] = remaining;
+    }
+}
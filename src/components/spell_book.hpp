@@ -1,5 +1,6 @@
 #pragma once
 
+#include "../asset_future.hpp"
 #include "../component.hpp"
 #include "../math.hpp"
 #include "../utils.hpp"
@@ -11,7 +12,9 @@ struct SpellData;
 class SpellBookComponent : public Component<SpellBookComponent> {
 public:
     void attach() override;
+    void detach() override;
     void update(const f32 dt) override;
+    void render(std::shared_ptr<Renderer> renderer) override;
     void addSpell(const std::shared_ptr<SpellData> spellData);
     void addSpellFile(const std::string& filePath);
     void castSpell(u32 index, const Vec2& target);
@@ -30,6 +33,8 @@ public:
 
 private:
     void autoEquipSpells();
+    void addLoadedSpells();
+    void swapReloaded(const IAssetPtr& previous, const IAssetPtr& fresh);
     auto determineGeometry() -> GeometryData;
     auto determineCollision() -> CollisionData;
 
@@ -37,9 +42,12 @@ private:
     std::array<std::shared_ptr<SpellData>, 4> spellSlots_;
     std::vector<std::shared_ptr<SpellData>> spells_;
     std::vector<std::string> spellFiles_;
+    // loaded in the background, added in file order once all of them are done
+    std::vector<AssetFuture<SpellData>> pendingSpells_;
     std::shared_ptr<SpellData> castedSpell_;
     std::unordered_map<std::shared_ptr<SpellData>, f32> cooldowns_;
     f32 castProgress_{0.0f};
     f32 castDuration_{0.0f};
     Vec2 target_{0.0f, 0.0f};
+    size_t reloadListenerId_{SIZE_MAX};
 };
@@ -41,7 +41,7 @@ void StatusEffectComponent::applyEffect(const SpellEffect& effect) {
 
     if(e.visual) {
         auto am = AssetManager::get();
-        auto visualEffect = am->load<StatusEffectData>(e.effectFilePath);
+        auto visualEffect = am->load<StatusEffectData>(e.effectAsset);
         if(!visualEffect) {
             ERROR("[STATUS EFFECT]: " + e.name +
                   " is flagged as visual but no visual data has been found");
@@ -0,0 +1,50 @@
+#include "tilemap.hpp"
+
+#include <algorithm>
+
+#include "../renderer.hpp"
+
+auto TilemapData::tile(u32 x, u32 y) const -> s32 {
+    return tiles[y * width + x];
+}
+
+auto TilemapData::chunkRect(u32 chunk) const -> Rect {
+    u32 firstColumn = (chunk % chunkColumns) * TILEMAP_CHUNK_SIZE;
+    u32 firstRow = (chunk / chunkColumns) * TILEMAP_CHUNK_SIZE;
+    u32 columns = std::min(TILEMAP_CHUNK_SIZE, width - firstColumn);
+    u32 rows = std::min(TILEMAP_CHUNK_SIZE, height - firstRow);
+
+    f32 size = static_cast<f32>(tileSize);
+    return {firstColumn * size, firstRow * size, columns * size, rows * size};
+}
+
+void TilemapComponent::setTilemap(std::shared_ptr<const TilemapData> tilemap) {
+    tilemap_ = tilemap;
+}
+
+void TilemapComponent::render(std::shared_ptr<Renderer> renderer) {
+    if(!tilemap_ || tilemap_->chunkColumns == 0 || tilemap_->chunkRows == 0) {
+        return;
+    }
+
+    // only the chunks under the camera are visited, however large the map is
+    Rect area = renderer->camera().visibleArea();
+    f32 chunkSize = static_cast<f32>(tilemap_->tileSize * TILEMAP_CHUNK_SIZE);
+    s32 lastColumn = static_cast<s32>(tilemap_->chunkColumns) - 1;
+    s32 lastRow = static_cast<s32>(tilemap_->chunkRows) - 1;
+    s32 minColumn = std::clamp(static_cast<s32>(std::floor(area.x / chunkSize)), 0, lastColumn);
+    s32 minRow = std::clamp(static_cast<s32>(std::floor(area.y / chunkSize)), 0, lastRow);
+    s32 maxColumn =
+        std::clamp(static_cast<s32>(std::floor((area.x + area.w) / chunkSize)), 0, lastColumn);
+    s32 maxRow =
+        std::clamp(static_cast<s32>(std::floor((area.y + area.h) / chunkSize)), 0, lastRow);
+
+    for(s32 row = minRow; row <= maxRow; row++) {
+        for(s32 column = minColumn; column <= maxColumn; column++) {
+            u32 chunk = static_cast<u32>(row) * tilemap_->chunkColumns + static_cast<u32>(column);
+            if(!tilemap_->emptyChunks[chunk]) {
+                renderer->queueRenderTerrainChunk(tilemap_, chunk);
+            }
+        }
+    }
+}
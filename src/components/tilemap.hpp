@@ -0,0 +1,41 @@
+#pragma once
+
+#include "../component.hpp"
+#include "../i_asset.hpp"
+#include "../math.hpp"
+#include "../texture_registry.hpp"
+
+// tiles per chunk side, each chunk is pre-rendered into one texture
+const u32 TILEMAP_CHUNK_SIZE = 16;
+
+/// Static ground tiles on a grid starting at the world origin. Immutable once loaded, so the
+/// render thread may read it while the simulation holds it.
+struct TilemapData : public IAsset {
+    // unique per loaded tilemap, keys the render thread's chunk cache
+    u32 id{0};
+    std::string tilesetFilePath;
+    TextureHandle tileset;
+    u32 tileSize{0};
+    u32 width{0};
+    u32 height{0};
+    // row major tileset indices, -1 leaves the tile empty
+    std::vector<s32> tiles;
+
+    u32 chunkColumns{0};
+    u32 chunkRows{0};
+    std::vector<bool> emptyChunks;
+
+    auto tile(u32 x, u32 y) const -> s32;
+    /// World rect covered by the chunk, chunks on the right and bottom edge may be cut short.
+    auto chunkRect(u32 chunk) const -> Rect;
+};
+
+/// Queues the chunks of its tilemap that overlap the camera.
+class TilemapComponent : public Component<TilemapComponent> {
+public:
+    void setTilemap(std::shared_ptr<const TilemapData> tilemap);
+    void render(std::shared_ptr<Renderer> renderer) override;
+
+private:
+    std::shared_ptr<const TilemapData> tilemap_;
+};
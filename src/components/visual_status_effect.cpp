@@ -6,6 +6,7 @@
 
 void VisualStatusEffectComponent::setTextureFile(const std::string& textureFilePath) {
     textureFilePath_ = textureFilePath;
+    texture_ = TextureRegistry::get().acquire(textureFilePath);
 }
 
 void VisualStatusEffectComponent::setRect(const Rect& rect) {
@@ -29,9 +30,9 @@ void VisualStatusEffectComponent::render(std::shared_ptr<Renderer> renderer) {
         sRect.x = animationComponent->frame() * sRect.w;
         sRect.y = animationComponent->index() * sRect.h;
 
-        renderer->queueRenderTexture(Strata::EFFECT, textureFilePath_, sRect, dRect);
+        renderer->queueRenderTexture(Strata::EFFECT, texture_, sRect, dRect);
         return;
     };
 
-    renderer->queueRenderTexture(Strata::EFFECT, textureFilePath_, sRect, dRect);
+    renderer->queueRenderTexture(Strata::EFFECT, texture_, sRect, dRect);
 }
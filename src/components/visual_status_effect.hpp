@@ -1,5 +1,6 @@
 #include "../component.hpp"
 #include "../math.hpp"
+#include "../texture_registry.hpp"
 
 #pragma once
 
@@ -12,5 +13,6 @@ public:
 
 private:
     std::string textureFilePath_;
+    TextureHandle texture_;
     Rect rect_;
 };
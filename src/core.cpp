@@ -1,6 +1,9 @@
 #include "core.hpp"
 
 #include "asset_manager.hpp"
+#include "components/culling.hpp"
+#include "components/particle_system.hpp"
+#include "components/player_control.hpp"
 #include "entity_structure_modifier.hpp"
 #include "loaders/animation_loader.hpp"
 #include "loaders/emitter_loader.hpp"
@@ -10,32 +13,67 @@
 #include "loaders/spell_loader.hpp"
 #include "loaders/status_effect_loader.hpp"
 #include "loaders/texture_loader.hpp"
+#include "loaders/tilemap_loader.hpp"
+#include "loaders/world_chunk_loader.hpp"
 #include "log.hpp"
+#include "texture_registry.hpp"
 #include "time.hpp"
-#include "ui.hpp"
 
 constexpr std::string gameTitle = "CES_test";
 constexpr s32 startWindowWidth = 1280;
 constexpr s32 startWindowHeight = 720;
 
-Core::Core() : running_(true) {
-    ui_ = std::make_unique<UI>();
+// how long the simulation sleeps at most when no tick is due
+constexpr f32 MAX_SIMULATION_IDLE = 0.002f;
+// render thread time per frame spent uploading textures decoded in the background
+constexpr std::chrono::microseconds FRAME_UPLOAD_BUDGET(500);
+// simulation thread time per tick spent creating entities, while building the scene and when
+// streamed chunks become active
+constexpr std::chrono::microseconds SCENE_INSTANTIATION_BUDGET(4000);
+
+Core::Core(const CoreOptions& options)
+    : options_(options),
+      window_(nullptr),
+      icon_(nullptr),
+      canvas_(nullptr),
+      running_(true),
+      tickCount_(0),
+      outputWidth_(0.0f),
+      outputHeight_(0.0f) {
+    if(!options_.headless) {
+        ui_ = std::make_unique<UI>();
+    }
 }
 
 Core::~Core() {
-    renderer_->destroy();
+    running_ = false;
+    if(simulationThread_.joinable()) {
+        simulationThread_.join();
+    }
+    // nothing uploads from here on, decode workers still waiting for room must not hang the exit
+    AssetManager::get()->cancelUploads();
+
+    // the ui shuts its backends down against a live renderer
+    ui_.reset();
+    if(renderer_) {
+        renderer_->destroy();
+    }
+    SDL_DestroySurface(canvas_);
     SDL_DestroySurface(icon_);
-    SDL_DestroyWindow(window_);
+    if(window_) {
+        SDL_DestroyWindow(window_);
+    }
     SDL_Quit();
 }
 
 bool Core::init() {
-    if(!initSDL()) {
+    bool initialized = options_.headless ? initHeadless() : initSDL();
+    if(!initialized) {
         ERROR("failed to init SDL");
         return false;
     }
 
-    if(!ui_->init(window_, renderer_)) {
+    if(ui_ && !ui_->init(window_, renderer_)) {
         ERROR("failed to init UI");
         return false;
     }
@@ -43,25 +81,58 @@ bool Core::init() {
     // game init
     auto am = AssetManager::get();
     am->setAssetRoot("assets");
+    // only when asked for, a pack left over from an earlier cook must not shadow the sources;
+    // missing blobs fall back to loose cooked blobs and then to the sources
+    if(!options_.packPath.empty()) {
+        am->openPack(options_.packPath);
+    }
+    am->setCookedRoot("cooked");
+    // textures neither packed nor cooked are decoded once, later starts read the pixels
+    am->setDecodeCache("decode_cache");
+    am->setMemoryBudget(options_.assetMemoryBudget);
+    if(options_.hotReload) {
+        am->watchAssets();
+    }
     am->registerLoader<SpellData>(std::make_shared<SpellLoader>());
-    am->registerLoader<Scene>(std::make_shared<SceneLoader>());
+    auto sceneLoader = std::make_shared<SceneLoader>();
+    am->registerLoader<Scene>(sceneLoader);
     am->registerLoader<EntityData>(std::make_shared<EntityLoader>());
     am->registerLoader<Texture>(std::make_shared<TextureLoader>(renderer_));
     am->registerLoader<AnimationData>(std::make_shared<AnimationLoader>());
     am->registerLoader<StatusEffectData>(std::make_shared<StatusEffectLoader>());
     am->registerLoader<EmitterData>(std::make_shared<EmitterLoader>());
     am->registerLoader<ParticleData>(std::make_shared<ParticleLoader>());
+    am->registerLoader<TilemapData>(std::make_shared<TilemapLoader>());
+    am->registerLoader<WorldChunkData>(std::make_shared<WorldChunkLoader>());
 
-    root_ = am->load<Scene>("scenes/level_1.json");
-
-    // Add the collision system to the root.
-    root_->addComponent(std::make_shared<CollisionSystem>());
+    // Everything the level refers to is loaded up front and in parallel, otherwise components
+    // load spells, emitters and prefabs when they attach, in the middle of a fight.
+    const std::string& sceneFile = options_.sceneFile;
+    auto references = sceneLoader->sceneReferences(am->getAssetPath(sceneFile).generic_string());
+    u32 failed = am->prefetch(
+        references, [this](u32 finished, u32 total) { showLoadingProgress(finished, total); });
+    if(failed > 0) {
+        ERROR("[CORE]: " + std::to_string(failed) + " assets failed to preload");
+    }
 
+    root_ = am->load<Scene>(sceneFile);
     if(!root_) {
+        ERROR("[CORE]: failed to load " + sceneFile);
         return false;
     }
 
-    root_->executeAttached();
+    // Add the collision system to the root.
+    root_->addComponent(std::make_shared<CollisionSystem>());
+    // Particle simulation runs as a single pass over all emitters after gameplay movement.
+    root_->addComponent(std::make_shared<ParticleSystem>());
+    // Hides off-screen entities before the rest of the scene renders.
+    root_->addComponent(std::make_shared<CullingSystem>());
+
+    // Windows build the scene over the first ticks while showing a loading screen. Headless runs
+    // have nothing to show, their first tick sees the complete scene.
+    if(options_.headless) {
+        root_->instantiate(std::chrono::microseconds::zero());
+    }
 
     return true;
 }
@@ -95,41 +166,271 @@ bool Core::initSDL() {
     return true;
 }
 
+bool Core::initHeadless() {
+    // no display needed, the dummy driver still delivers quit requests from signals
+    SDL_SetHint(SDL_HINT_VIDEO_DRIVER, "dummy");
+    if(!SDL_Init(SDL_INIT_VIDEO)) {
+        ERROR(SDL_GetError());
+        return false;
+    }
+
+    canvas_ = SDL_CreateSurface(startWindowWidth, startWindowHeight, SDL_PIXELFORMAT_RGBA32);
+    if(!canvas_) {
+        ERROR(SDL_GetError());
+        return false;
+    }
+
+    renderer_ = std::make_shared<Renderer>(Renderer::initSoftware(canvas_));
+
+    return true;
+}
+
+void Core::showLoadingProgress(u32 finished, u32 total) {
+    if(options_.headless) {
+        return;
+    }
+    // keeps the window responsive while loading
+    SDL_PumpEvents();
+    renderer_->renderLoadingScreen(static_cast<f32>(finished) / static_cast<f32>(total));
+}
+
 s32 Core::run() {
     if(!init()) {
         return 1;
     }
 
+    if(options_.headless) {
+        return runHeadless();
+    }
+
+    Vec2 outputSize = renderer_->outputSize();
+    outputWidth_ = outputSize.x;
+    outputHeight_ = outputSize.y;
+
+    // the first frame is built here so the window never shows an empty snapshot
+    publishFrame();
+    simulationThread_ = std::thread([this]() { simulate(); });
+
     SDL_Event event;
     while(running_) {
         while(SDL_PollEvent(&event)) {
             handleEvents(event);
         }
-        Time::get().update();
-
-        while(Time::get().isTimeToUpdate()) {
-            // Apply all the modifications queued from the previous frame
-            EntityStructureModifier::applyStructureModifications();
-            {
-                // Begin our update cycle
-                EntityStructureModifier::beginUpdate();
-                update(Time::get().DELTA_TIME);
-                postUpdate(Time::get().DELTA_TIME);
-                EntityStructureModifier::endUpdate();
-            }
-        }
         render();
     }
+
+    simulationThread_.join();
     return 0;
 }
 
 void Core::handleEvents(const SDL_Event& event) {
-    root_->handleEvents(event);
     ui_->handleEvents(event);
 
     if(event.type == SDL_EVENT_QUIT) {
         running_ = false;
+        return;
+    }
+
+    // target textures lose their contents on a reset, cached terrain is rebuilt on demand
+    if(event.type == SDL_EVENT_RENDER_TARGETS_RESET ||
+       event.type == SDL_EVENT_RENDER_DEVICE_RESET) {
+        renderer_->invalidateRenderTargets();
+        return;
+    }
+
+    // the game works in world coordinates, the ui stays in screen coordinates
+    SDL_Event worldEvent = event;
+    const Camera& camera = snapshots_.readSlot().camera;
+    switch(event.type) {
+        case SDL_EVENT_KEY_DOWN:
+        case SDL_EVENT_KEY_UP:
+            break;
+        case SDL_EVENT_MOUSE_MOTION: {
+            Vec2 position = camera.screenToWorld({event.motion.x, event.motion.y});
+            worldEvent.motion.x = position.x;
+            worldEvent.motion.y = position.y;
+            break;
+        }
+        case SDL_EVENT_MOUSE_BUTTON_DOWN:
+        case SDL_EVENT_MOUSE_BUTTON_UP: {
+            Vec2 position = camera.screenToWorld({event.button.x, event.button.y});
+            worldEvent.button.x = position.x;
+            worldEvent.button.y = position.y;
+            break;
+        }
+        default:
+            // anything else may point into SDL owned memory, the scene does not need it
+            return;
+    }
+
+    std::lock_guard lock(inputMutex_);
+    if(event.type == SDL_EVENT_MOUSE_MOTION) {
+        mouseScreenPosition_ = Vec2{event.motion.x, event.motion.y};
+    }
+    pendingEvents_.push_back(worldEvent);
+}
+
+void Core::render() {
+    Vec2 outputSize = renderer_->outputSize();
+    outputWidth_ = outputSize.x;
+    outputHeight_ = outputSize.y;
+
+    // without a new frame the last one is drawn again
+    snapshots_.acquire();
+    const FrameSnapshot& frame = snapshots_.readSlot();
+
+    // Textures decoded in the background are uploaded here, a few per frame when many finish at
+    // once. Until then their sprites are skipped. Textures unused for a while are handed back to
+    // the cache first, so its budget can evict them.
+    TextureRegistry::get().releaseIdle();
+    AssetManager::get()->update(FRAME_UPLOAD_BUDGET);
+
+    if(frame.loadingProgress < 1.0f) {
+        renderer_->renderLoadingScreen(frame.loadingProgress);
+        return;
     }
+
+    renderer_->clear();
+    renderer_->executeRenderCalls(frame, frame.alphaAt(FrameSnapshot::Clock::now()));
+    ui_->render(frame);
+
+    auto commands = ui_->takeCommands();
+    if(!commands.empty()) {
+        std::lock_guard lock(inputMutex_);
+        pendingCommands_.insert(pendingCommands_.end(), commands.begin(), commands.end());
+    }
+
+    renderer_->present();
+}
+
+s32 Core::runHeadless() {
+    INFO("[CORE]: running headless");
+
+    SDL_Event event;
+    auto start = std::chrono::steady_clock::now();
+    while(running_ && (options_.ticks == 0 || tickCount_ < options_.ticks)) {
+        while(SDL_PollEvent(&event)) {
+            if(event.type == SDL_EVENT_QUIT) {
+                running_ = false;
+            }
+        }
+        AssetManager::get()->update();
+
+        if(!options_.realtime) {
+            step();
+            continue;
+        }
+
+        Time::get().update();
+        while(Time::get().isTimeToUpdate()) {
+            step();
+        }
+        f32 untilNextTick = (1.0f - Time::get().alpha()) * Time::get().deltaTime();
+        std::this_thread::sleep_for(
+            std::chrono::duration<f32>(std::min(untilNextTick, MAX_SIMULATION_IDLE)));
+    }
+    std::chrono::duration<f32> elapsed = std::chrono::steady_clock::now() - start;
+
+    INFO(
+        "[CORE]: simulated " + std::to_string(tickCount_) + " ticks in " +
+        std::to_string(elapsed.count()) + "s");
+
+    if(!options_.capturePath.empty() && !captureFrame()) {
+        return 1;
+    }
+    return 0;
+}
+
+bool Core::captureFrame() {
+    outputWidth_ = static_cast<f32>(canvas_->w);
+    outputHeight_ = static_cast<f32>(canvas_->h);
+    publishFrame();
+    snapshots_.acquire();
+
+    // The state after the last step, nothing to interpolate. The first pass requests the
+    // textures that are not loaded yet, the capture has to show them.
+    renderer_->executeRenderCalls(snapshots_.readSlot(), 1.0f);
+    TextureRegistry::get().finishLoads();
+    renderer_->clear();
+    renderer_->executeRenderCalls(snapshots_.readSlot(), 1.0f);
+
+    if(!renderer_->capture(options_.capturePath)) {
+        return false;
+    }
+    INFO("[CORE]: captured frame to " + options_.capturePath);
+    return true;
+}
+
+void Core::simulate() {
+    while(running_) {
+        processInput();
+        Time::get().update();
+
+        bool ticked = false;
+        while(Time::get().isTimeToUpdate()) {
+            step();
+            ticked = true;
+        }
+        if(options_.ticks != 0 && tickCount_ >= options_.ticks) {
+            running_ = false;
+        }
+
+        if(ticked) {
+            publishFrame();
+            continue;
+        }
+
+        // nothing changed, wait for the next tick instead of spinning
+        f32 untilNextTick = (1.0f - Time::get().alpha()) * Time::get().deltaTime();
+        std::this_thread::sleep_for(
+            std::chrono::duration<f32>(std::min(untilNextTick, MAX_SIMULATION_IDLE)));
+    }
+}
+
+void Core::processInput() {
+    {
+        std::lock_guard lock(inputMutex_);
+        std::swap(events_, pendingEvents_);
+        std::swap(commands_, pendingCommands_);
+    }
+
+    for(auto& event : events_) {
+        root_->handleEvents(event);
+    }
+    for(auto& command : commands_) {
+        UI::apply(root_, command);
+    }
+    events_.clear();
+    commands_.clear();
+}
+
+void Core::step() {
+    // between ticks, so components swap reloaded assets before anything uses them again
+    if(options_.hotReload) {
+        AssetManager::get()->reloadChanged();
+    }
+
+    // Headless runs are replayed and compared, what exists in which tick must not depend on
+    // the wall clock. They build and stream without a budget, loading chunks right away.
+    auto budget = options_.headless ? std::chrono::microseconds::zero()
+                                    : SCENE_INSTANTIATION_BUDGET;
+    // the game starts once the scene is complete, until then ticks only build it
+    if(!root_->instantiated()) {
+        root_->instantiate(budget);
+        return;
+    }
+    root_->stream(budget);
+
+    // Apply all the modifications queued from the previous frame
+    EntityStructureModifier::applyStructureModifications();
+    {
+        // Begin our update cycle
+        EntityStructureModifier::beginUpdate();
+        update(Time::get().deltaTime());
+        postUpdate(Time::get().deltaTime());
+        EntityStructureModifier::endUpdate();
+    }
+    tickCount_++;
 }
 
 void Core::update(const f32 dt) {
@@ -140,10 +441,53 @@ void Core::postUpdate(const f32 dt) {
     root_->postUpdate(dt);
 }
 
-void Core::render() {
-    renderer_->clear();
+void Core::publishFrame() {
+    FrameSnapshot& frame = snapshots_.writeSlot();
+    renderer_->beginFrame(frame, {outputWidth_, outputHeight_});
+    // set before anything is queued, commands are moved into screen space as they are queued
+    if(auto player = findPlayer()) {
+        followCamera(player->transform().position);
+    }
     root_->render(renderer_);
-    renderer_->executeRenderCalls();
-    ui_->render(root_);
-    renderer_->present();
+    renderer_->endFrame();
+    UI::capture(root_, frame);
+    frame.publishTime = FrameSnapshot::Clock::now();
+    frame.publishAlpha = Time::get().alpha();
+    frame.deltaTime = Time::get().deltaTime();
+    frame.loadingProgress = root_->instantiationProgress();
+    snapshots_.publish();
+}
+
+void Core::followCamera(const Vec2& point) {
+    Camera& camera = renderer_->camera();
+    camera.centerOn(point);
+    Vec2 position = camera.position();
+    if(position.x == cameraPosition_.x && position.y == cameraPosition_.y) {
+        return;
+    }
+    cameraPosition_ = position;
+
+    std::lock_guard lock(inputMutex_);
+    if(!mouseScreenPosition_) {
+        return;
+    }
+    Vec2 pointer = camera.screenToWorld(*mouseScreenPosition_);
+    SDL_Event event{};
+    event.type = SDL_EVENT_MOUSE_MOTION;
+    event.motion.x = pointer.x;
+    event.motion.y = pointer.y;
+    pendingEvents_.push_back(event);
+}
+
+auto Core::findPlayer() -> EntityPtr {
+    if(auto player = player_.lock()) {
+        return player;
+    }
+    for(auto& child : root_->children()) {
+        if(child->component<PlayerControlComponent>()) {
+            player_ = child;
+            return child;
+        }
+    }
+    return nullptr;
 }
@@ -2,15 +2,46 @@
 
 #include <SDL3/SDL.h>
 
+#include <atomic>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+#include "frame_snapshot.hpp"
 #include "renderer.hpp"
+#include "ui.hpp"
 #include "utils.hpp"
 
 class AssetManager;
 class Scene;
-class UI;
+
+struct CoreOptions {
+    /// No window, no ui and no event loop, for servers and benchmarks. Frames are only drawn, by
+    /// a software renderer, when capturePath is set.
+    bool headless{false};
+    /// Headless runs step as fast as possible unless this paces them at the tick rate.
+    bool realtime{false};
+    /// Stops after this many simulation steps, 0 runs until quit.
+    u32 ticks{0};
+    /// Headless only, the last frame is saved here as a PNG.
+    std::string capturePath;
+    /// Reloads edited assets while running, see AssetManager::watchAssets.
+    bool hotReload{false};
+    /// Unreferenced assets are evicted once the cache grows beyond this, 0 keeps everything.
+    size_t assetMemoryBudget{256 * 1024 * 1024};
+    /// A pack written by the cook_assets target, empty loads from loose cooked blobs and sources.
+    std::string packPath;
+    /// The level to play, relative to the asset root.
+    std::string sceneFile{"scenes/level_1.json"};
+};
+
+/// The main thread owns the window, polls events and presents frames. The simulation runs on its
+/// own thread and hands frames over through snapshots, so a blocking present never holds back a
+/// simulation tick. SDL only allows video and event calls from the main thread, which is why the
+/// simulation is the one moved off it.
 class Core {
 public:
-    Core();
+    Core(const CoreOptions& options = {});
     ~Core();
 
     s32 run();
@@ -18,16 +49,51 @@ public:
 private:
     bool init();
     bool initSDL();
+    bool initHeadless();
+    void showLoadingProgress(u32 finished, u32 total);
     void handleEvents(const SDL_Event& event);
+    void render();
+    s32 runHeadless();
+    bool captureFrame();
+
+    // simulation thread
+    void simulate();
+    void processInput();
+    void step();
     void update(const f32 dt);
     void postUpdate(const f32 dt);
-    void render();
+    void publishFrame();
+    /// The entity the camera follows, the first child of the scene with player control.
+    auto findPlayer() -> EntityPtr;
+    /// Centers the camera on the point. The pointer keeps its place on screen while the world
+    /// moves under it, the next tick sees it at its new world position.
+    void followCamera(const Vec2& point);
 
 private:
+    CoreOptions options_;
     SDL_Window* window_;
     SDL_Surface* icon_;
+    // headless render target
+    SDL_Surface* canvas_;
     std::shared_ptr<Renderer> renderer_;
     std::unique_ptr<UI> ui_;
-    bool running_;
+    std::atomic<bool> running_;
     std::shared_ptr<Scene> root_;
+    EntityHandle player_;
+    Vec2 cameraPosition_{0.0f, 0.0f};
+    u32 tickCount_;
+
+    FrameSnapshotBuffer snapshots_;
+    std::thread simulationThread_;
+    std::atomic<f32> outputWidth_;
+    std::atomic<f32> outputHeight_;
+
+    // handed from the main thread to the simulation
+    std::mutex inputMutex_;
+    std::vector<SDL_Event> pendingEvents_;
+    std::vector<UICommand> pendingCommands_;
+    // where the pointer last was on screen, its world position moves with the camera
+    std::optional<Vec2> mouseScreenPosition_;
+    std::vector<SDL_Event> events_;
+    std::vector<UICommand> commands_;
 };
@@ -0,0 +1,57 @@
+#include "debug_draw.hpp"
+
+void DebugDrawBuffer::clear() {
+    for(auto& batch : batches_) {
+        batch.rects.clear();
+        batch.rectOffsets.clear();
+        batch.points.clear();
+        batch.polylines.clear();
+    }
+}
+
+void DebugDrawBuffer::addRect(const Rect& rect, const SDL_Color& color, const Vec2& offset) {
+    auto& target = batch(color);
+    target.rects.push_back({rect.x, rect.y, rect.w, rect.h});
+    target.rectOffsets.push_back(offset);
+}
+
+void DebugDrawBuffer::addPolyline(
+    std::span<const Vec2> points, const SDL_Color& color, const Vec2& offset) {
+    if(points.size() < 2) {
+        return;
+    }
+
+    auto& target = batch(color);
+    target.polylines.push_back(
+        {static_cast<u32>(target.points.size()), static_cast<u32>(points.size()), offset});
+    for(auto& point : points) {
+        target.points.push_back({point.x, point.y});
+    }
+}
+
+auto DebugDrawBuffer::batches() const -> const std::vector<DebugDrawBatch>& {
+    return batches_;
+}
+
+bool DebugDrawBuffer::empty() const {
+    for(auto& batch : batches_) {
+        if(!batch.rects.empty() || !batch.polylines.empty()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+auto DebugDrawBuffer::batch(const SDL_Color& color) -> DebugDrawBatch& {
+    // an overlay uses a handful of colors, a linear search beats hashing
+    for(auto& batch : batches_) {
+        if(batch.color.r == color.r && batch.color.g == color.g && batch.color.b == color.b &&
+           batch.color.a == color.a) {
+            return batch;
+        }
+    }
+
+    batches_.push_back({});
+    batches_.back().color = color;
+    return batches_.back();
+}
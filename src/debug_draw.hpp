@@ -0,0 +1,44 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+
+#include <span>
+#include <vector>
+
+#include "math.hpp"
+
+/// A run of points inside DebugDrawBatch::points drawn as one connected line strip.
+struct DebugPolyline {
+    u32 first;
+    u32 count;
+    // the command motion offset, see RenderMotion
+    Vec2 offset;
+};
+
+/// Debug shapes sharing a draw color, in screen space.
+struct DebugDrawBatch {
+    SDL_Color color;
+    std::vector<SDL_FRect> rects;
+    std::vector<Vec2> rectOffsets;
+    std::vector<SDL_FPoint> points;
+    std::vector<DebugPolyline> polylines;
+};
+
+/// Debug overlay shapes of a frame grouped by color, so the render thread draws all outlines of a
+/// color with a single SDL_RenderRects call and each line strip with a single SDL_RenderLines
+/// call. Circles are stored as closed strips. Drawn on top of everything else.
+class DebugDrawBuffer {
+public:
+    /// Keeps the batches and their capacity, a steady overlay does not allocate.
+    void clear();
+    void addRect(const Rect& rect, const SDL_Color& color, const Vec2& offset);
+    void addPolyline(std::span<const Vec2> points, const SDL_Color& color, const Vec2& offset);
+    auto batches() const -> const std::vector<DebugDrawBatch>&;
+    bool empty() const;
+
+private:
+    auto batch(const SDL_Color& color) -> DebugDrawBatch&;
+
+private:
+    std::vector<DebugDrawBatch> batches_;
+};
@@ -2,10 +2,16 @@
 
 #include "component.hpp"
 #include "entity_structure_modifier.hpp"
+#include "renderer.hpp"
 #include "scoped.hpp"
 
 Entity::Entity(const std::string& name, bool lazyAttach)
-    : name_(name), lazyAttach_(lazyAttach), active_(true) {
+    : name_(name),
+      transform_{},
+      previousTransform_{},
+      lazyAttach_(lazyAttach),
+      active_(true),
+      culled_(false) {
 }
 
 Entity::~Entity() {
@@ -68,8 +74,14 @@ const Transform& Entity::transform() const {
     return transform_;
 }
 
+const Transform& Entity::previousTransform() const {
+    return previousTransform_;
+}
+
 void Entity::executeAttached() {
     lazyAttach_ = false;
+    // nothing to interpolate from before the first update
+    previousTransform_ = transform_;
 
     for(auto& c : components_) {
         c->attach();
@@ -88,6 +100,14 @@ void Entity::setActive(bool active) {
     active_ = active;
 }
 
+bool Entity::isCulled() const {
+    return culled_;
+}
+
+void Entity::setCulled(bool culled) {
+    culled_ = culled;
+}
+
 void Entity::handleEvents(const SDL_Event& event) {
     if(!active_) return;
 
@@ -103,6 +123,8 @@ void Entity::handleEvents(const SDL_Event& event) {
 void Entity::update(const f32 dt) {
     if(!active_) return;
 
+    previousTransform_ = transform_;
+
     for(auto& u : components_) {
         u->update(dt);
     }
@@ -125,7 +147,16 @@ void Entity::postUpdate(const f32 dt) {
 }
 
 void Entity::render(std::shared_ptr<Renderer> renderer) {
-    if(!active_) return;
+    if(!active_ || culled_) return;
+
+    // children that do not move themselves, like attached effects, move along with their parent
+    RenderMotion parentMotion = renderer->motion();
+    Vec2 offset = transform_.position - previousTransform_.position;
+    f32 spin = std::remainder(
+        transform_.rotation - previousTransform_.rotation, 2.0f * static_cast<f32>(M_PI));
+    if(offset.x != 0.0f || offset.y != 0.0f || spin != 0.0f) {
+        renderer->setMotion({offset, spin});
+    }
 
     for(auto& r : components_) {
         r->render(renderer);
@@ -134,4 +165,6 @@ void Entity::render(std::shared_ptr<Renderer> renderer) {
     for(auto&& c : children_) {
         c->render(renderer);
     }
+
+    renderer->setMotion(parentMotion);
 }
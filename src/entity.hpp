@@ -32,6 +32,8 @@ public:
     auto root() const -> EntityPtr;
 
     const Transform& transform() const;
+    /// The transform at the start of the last update.
+    const Transform& previousTransform() const;
     constexpr auto name() -> std::string const& {
         return name_;
     }
@@ -39,6 +41,9 @@ public:
     void executeAttached();
     bool isActive() const;
     void setActive(bool active = true);
+    /// A culled entity still updates but skips rendering, together with its children.
+    bool isCulled() const;
+    void setCulled(bool culled = true);
     void handleEvents(const SDL_Event& event);
     void update(const f32 dt);
     void postUpdate(const f32 dt);
@@ -49,11 +54,13 @@ private:
 
     std::string name_;
     Transform transform_;
+    Transform previousTransform_;
     EntityHandle parent_;
     std::vector<ComponentPtr> components_;
     std::vector<EntityPtr> children_;
     bool lazyAttach_;
     bool active_;
+    bool culled_;
 };
 
 template <typename T>
@@ -5,4 +5,6 @@ using json = nlohmann::json;
 
 struct EntityData : public IAsset {
     json data;
+    // heap taken by the tree, estimated once from the size it was parsed from
+    size_t treeBytes{0};
 };
@@ -28,7 +28,7 @@ public:
     void unsubscribe(size_t id) {
         // signaling
         assert(!walking_ && "Do not unsubscribe while signaling");
-        assert(id < freeItems_.size());
+        assert(id < callbacks_.size());
         callbacks_[id] = nullptr;
         freeItems_.push_back(id);
     }
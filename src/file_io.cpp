@@ -4,73 +4,55 @@
 
 namespace FileIO {
 
-    std::expected <std::vector<char>, std::error_code> readBinaryFile(const std::string& fileName) {
-
-        std::filesystem::path filePath(fileName);
-        if(!std::filesystem::exists(filePath)) {
-            return std::unexpected(std::make_error_code(std::errc::no_such_file_or_directory));
-        }
-
-        if(std::filesystem::is_directory(filePath)) {
-            return std::unexpected(std::make_error_code(std::errc::is_a_directory));
-        }
-
-        if(!std::filesystem::is_regular_file(filePath)) {
-            return std::unexpected(std::make_error_code(std::errc::bad_file_descriptor));
+    namespace {
+        // a single stat instead of one per check
+        std::error_code checkReadable(const std::filesystem::path& filePath) {
+            std::error_code error;
+            auto status = std::filesystem::status(filePath, error);
+            if(!std::filesystem::exists(status)) {
+                return std::make_error_code(std::errc::no_such_file_or_directory);
+            }
+            if(std::filesystem::is_directory(status)) {
+                return std::make_error_code(std::errc::is_a_directory);
+            }
+            if(!std::filesystem::is_regular_file(status)) {
+                return std::make_error_code(std::errc::bad_file_descriptor);
+            }
+            return {};
         }
 
-        std::ifstream file(fileName, std::ios::in | std::ios::binary);
-
-        if(!file.is_open()) {
-            return std::unexpected(std::make_error_code(std::errc::io_error));
-        }
+        template <class Container>
+        std::expected<Container, std::error_code> readWholeFile(const std::string& fileName) {
+            if(auto error = checkReadable(fileName)) {
+                return std::unexpected(error);
+            }
 
-        file.seekg(0, file.end);
-        std::streampos length = file.tellg();
-        file.seekg(0, file.beg);
+            std::ifstream file(fileName, std::ios::in | std::ios::binary | std::ios::ate);
+            if(!file.is_open()) {
+                return std::unexpected(std::make_error_code(std::errc::io_error));
+            }
 
-        std::vector<char> content;
-        content.resize(length);
+            std::streampos length = file.tellg();
+            file.seekg(0, file.beg);
 
-        file.read(content.data(), length);
+            Container content;
+            content.resize(length);
+            file.read(content.data(), length);
 
-        if(file.fail()) {
-            return std::unexpected(std::make_error_code(std::errc::io_error));
+            if(file.fail()) {
+                return std::unexpected(std::make_error_code(std::errc::io_error));
+            }
+            return content;
         }
-        return content;
     }
 
-    std::expected<std::string, std::error_code> readTextFile(const std::string& fileName) {
-
-        std::filesystem::path filePath(fileName);
-        if(!std::filesystem::exists(filePath)) {
-            return std::unexpected(std::make_error_code(std::errc::no_such_file_or_directory));
-        }
-
-        if(std::filesystem::is_directory(filePath)) {
-            return std::unexpected(std::make_error_code(std::errc::is_a_directory));
-        }
-
-        if(!std::filesystem::is_regular_file(filePath)) {
-            return std::unexpected(std::make_error_code(std::errc::bad_file_descriptor));
-        }
-
-        std::ifstream file(fileName, std::ios::in);
-
-        if(!file.is_open()) {
-            return std::unexpected(std::make_error_code(std::errc::io_error));
-        }
-
-        std::string content, line;
-
-        while(std::getline(file, line)) {
-            content += line;
-            if(!file.eof()) {
-                content += '\n';
-            }
-        }
+    std::expected <std::vector<char>, std::error_code> readBinaryFile(const std::string& fileName) {
+        return readWholeFile<std::vector<char>>(fileName);
+    }
 
-        return content;
+    std::expected<std::string, std::error_code> readTextFile(const std::string& fileName) {
+        // read in one go, line endings are left as they are, the parsers do not care
+        return readWholeFile<std::string>(fileName);
     }
 
     std::expected<void, std::error_code> writeTextFile(const std::string& fileName, const std::string& content, bool append) {
@@ -0,0 +1,35 @@
+#include "frame_snapshot.hpp"
+
+#include <algorithm>
+
+auto FrameSnapshot::alphaAt(Clock::time_point now) const -> f32 {
+    if(deltaTime <= 0.0f) {
+        return 1.0f;
+    }
+    // past 1 the next frame is late, hold the latest state rather than extrapolate
+    std::chrono::duration<f32> elapsed = now - publishTime;
+    return std::min(publishAlpha + elapsed.count() / deltaTime, 1.0f);
+}
+
+FrameSnapshotBuffer::FrameSnapshotBuffer() : write_(0), read_(1), ready_(2) {
+}
+
+auto FrameSnapshotBuffer::writeSlot() -> FrameSnapshot& {
+    return slots_[write_];
+}
+
+void FrameSnapshotBuffer::publish() {
+    write_ = ready_.exchange(write_ | FRESH_BIT, std::memory_order_acq_rel) & SLOT_MASK;
+}
+
+bool FrameSnapshotBuffer::acquire() {
+    if(!(ready_.load(std::memory_order_acquire) & FRESH_BIT)) {
+        return false;
+    }
+    read_ = ready_.exchange(read_, std::memory_order_acq_rel) & SLOT_MASK;
+    return true;
+}
+
+auto FrameSnapshotBuffer::readSlot() const -> const FrameSnapshot& {
+    return slots_[read_];
+}
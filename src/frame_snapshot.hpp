@@ -0,0 +1,109 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+
+#include "camera.hpp"
+#include "debug_draw.hpp"
+#include "components/tilemap.hpp"
+#include "renderer.hpp"
+
+struct HUDSpell {
+    std::string name;
+    bool onCooldown{false};
+};
+
+struct HUDSpellSlot {
+    // empty for an unassigned slot
+    std::string name;
+    bool onCooldown{false};
+    f32 cooldown{0.0f};
+    f32 cooldownProgress{0.0f};
+};
+
+/// Everything the hud shows about the player, copied out of the components by the simulation.
+struct HUDSnapshot {
+    bool hasPlayer{false};
+    bool hasXP{false};
+    bool hasSpellBook{false};
+    bool hasLife{false};
+    bool hasMana{false};
+
+    std::string playerName;
+    u32 level{0};
+
+    bool maxLevel{false};
+    u32 currentXP{0};
+    u32 nextLevelXP{0};
+
+    bool casting{false};
+    bool interruptible{false};
+    std::string castName;
+    f32 castProgress{0.0f};
+
+    bool dead{false};
+    f32 lifeCurrent{0.0f};
+    f32 lifeMax{0.0f};
+    f32 manaCurrent{0.0f};
+    f32 manaMax{0.0f};
+
+    std::array<HUDSpellSlot, 4> slots;
+    std::vector<HUDSpell> spells;
+};
+
+struct SceneNodeSnapshot {
+    std::string name;
+    // type names have static storage
+    std::vector<const char*> components;
+};
+
+/// One published frame. Filled on the simulation thread and only read by the render thread once
+/// published, so drawing never touches the entity tree. Containers are reused between frames.
+struct FrameSnapshot {
+    using Clock = std::chrono::steady_clock;
+
+    /// The interpolation alpha at the given time, Time::alpha() when published advanced by the
+    /// time passed since then.
+    auto alphaAt(Clock::time_point now) const -> f32;
+
+    std::vector<RenderCommand> commands;
+    // keeps the tilemaps referenced by terrain commands alive while the frame is drawn
+    std::vector<std::shared_ptr<const TilemapData>> tilemaps;
+    std::vector<OverlayBar> overlayBars;
+    DebugDrawBuffer debug;
+    Clock::time_point publishTime;
+    f32 publishAlpha{1.0f};
+    f32 deltaTime{0.0f};
+    /// Below 1 while the scene is still being built, the frame then only shows a loading screen.
+    f32 loadingProgress{1.0f};
+    Camera camera;
+    HUDSnapshot hud;
+    std::string sceneName;
+    std::vector<SceneNodeSnapshot> sceneNodes;
+};
+
+/// Triple buffered frames. The simulation owns one slot for writing, the renderer one for
+/// reading and the third holds the latest published frame, swapped with a single atomic exchange
+/// so neither side ever waits for the other.
+class FrameSnapshotBuffer {
+public:
+    FrameSnapshotBuffer();
+
+    /// simulation thread
+    auto writeSlot() -> FrameSnapshot&;
+    void publish();
+
+    /// render thread, returns false when nothing new was published since the last call
+    bool acquire();
+    auto readSlot() const -> const FrameSnapshot&;
+
+private:
+    // the ready slot index plus a flag telling whether it holds an unread frame
+    static constexpr u32 SLOT_MASK = 0x3;
+    static constexpr u32 FRESH_BIT = 0x4;
+
+    std::array<FrameSnapshot, 3> slots_;
+    u32 write_;
+    u32 read_;
+    std::atomic<u32> ready_;
+};
@@ -1,5 +1,6 @@
 #include "animation_loader.hpp"
 
+#include "../binary_io.hpp"
 #include "../file_io.hpp"
 
 auto AnimationLoader::load(AssetManager& assetManager, const std::string& filePath) -> IAssetPtr {
@@ -18,6 +19,33 @@ auto AnimationLoader::load(AssetManager& assetManager, const std::string& filePa
     return std::make_shared<AnimationData>(animation.value());
 }
 
+bool AnimationLoader::cook(const IAsset& asset, BinaryWriter& writer) const {
+    auto& animation = static_cast<const AnimationData&>(asset);
+    writer.writeString(animation.name);
+    writer.writeU32(animation.index);
+    writer.writeU32(animation.frameCount);
+    writer.writeF32(animation.frameDuration);
+    writer.writeBool(animation.looping);
+    return true;
+}
+
+auto AnimationLoader::loadCooked(AssetManager& assetManager, BinaryReader& reader) -> IAssetPtr {
+    AnimationData animation;
+    animation.name = reader.readString();
+    animation.index = reader.readU32();
+    animation.frameCount = reader.readU32();
+    animation.frameDuration = reader.readF32();
+    animation.looping = reader.readBool();
+    if(!reader.ok()) {
+        return nullptr;
+    }
+    return std::make_shared<AnimationData>(animation);
+}
+
+auto AnimationLoader::memoryUsage(const IAsset& asset) const -> size_t {
+    return sizeof(AnimationData);
+}
+
 auto AnimationLoader::parseAnimation(const std::string& source)
     -> std::expected<AnimationData, JSONParserError> {
     json animationJSON;
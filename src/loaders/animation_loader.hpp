@@ -7,6 +7,9 @@
 class AnimationLoader : public IAssetLoader, JSONParser {
 public:
     auto load(AssetManager& assetManager, const std::string& filePath) -> IAssetPtr override;
+    bool cook(const IAsset& asset, BinaryWriter& writer) const override;
+    auto loadCooked(AssetManager& assetManager, BinaryReader& reader) -> IAssetPtr override;
+    auto memoryUsage(const IAsset& asset) const -> size_t override;
 
 private:
     auto parseAnimation(const std::string& source) -> std::expected<AnimationData, JSONParserError>;
@@ -2,6 +2,7 @@
 
 #include <magic_enum/magic_enum.hpp>
 
+#include "../binary_io.hpp"
 #include "../file_io.hpp"
 
 auto EmitterLoader::load(AssetManager& assetManager, const std::string& filePath) -> IAssetPtr {
@@ -20,6 +21,40 @@ auto EmitterLoader::load(AssetManager& assetManager, const std::string& filePath
     return std::make_shared<EmitterData>(emitter.value());
 }
 
+void EmitterLoader::references(const IAsset& asset, std::vector<AssetReference>& out) const {
+    auto& emitter = static_cast<const EmitterData&>(asset);
+    out.push_back({typeid(ParticleData), emitter.particleDataFile});
+}
+
+bool EmitterLoader::cook(const IAsset& asset, BinaryWriter& writer) const {
+    auto& emitter = static_cast<const EmitterData&>(asset);
+    writer.writeString(emitter.particleDataFile);
+    writer.writeF32(emitter.spawnRate);
+    writer.writeU32(emitter.maxParticles);
+    writer.writeEnum(emitter.shape);
+    writer.writeF32(emitter.arc);
+    writer.writeF32(emitter.directionAngle);
+    return true;
+}
+
+auto EmitterLoader::loadCooked(AssetManager& assetManager, BinaryReader& reader) -> IAssetPtr {
+    EmitterData emitter;
+    emitter.particleDataFile = reader.readString();
+    emitter.spawnRate = reader.readF32();
+    emitter.maxParticles = reader.readU32();
+    emitter.shape = reader.readEnum<EmitterShape>();
+    emitter.arc = reader.readF32();
+    emitter.directionAngle = reader.readF32();
+    if(!reader.ok()) {
+        return nullptr;
+    }
+    return std::make_shared<EmitterData>(emitter);
+}
+
+auto EmitterLoader::memoryUsage(const IAsset& asset) const -> size_t {
+    return sizeof(EmitterData);
+}
+
 auto EmitterLoader::parseEmitter(const std::string& source)
     -> std::expected<EmitterData, JSONParserError> {
     json emitterJSON;
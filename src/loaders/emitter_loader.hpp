@@ -7,6 +7,10 @@
 class EmitterLoader : public IAssetLoader, JSONParser {
 public:
     auto load(AssetManager& assetManager, const std::string& filePath) -> IAssetPtr override;
+    void references(const IAsset& asset, std::vector<AssetReference>& out) const override;
+    bool cook(const IAsset& asset, BinaryWriter& writer) const override;
+    auto loadCooked(AssetManager& assetManager, BinaryReader& reader) -> IAssetPtr override;
+    auto memoryUsage(const IAsset& asset) const -> size_t override;
 
 private:
     auto parseEmitter(const std::string& source) -> std::expected<EmitterData, JSONParserError>;
@@ -1,6 +1,12 @@
 #include "entity_loader.hpp"
 
+#include "../binary_io.hpp"
+#include "../components/spell.hpp"
 #include "../file_io.hpp"
+#include "../texture.hpp"
+
+// a parsed json tree takes a few times the text or CBOR it came from
+const size_t JSON_TREE_BYTES_PER_SOURCE_BYTE = 4;
 
 auto EntityLoader::load(AssetManager& assetManager, const std::string& filePath) -> IAssetPtr {
     auto eDataSource = FileIO::readTextFile(filePath);
@@ -15,7 +21,72 @@ auto EntityLoader::load(AssetManager& assetManager, const std::string& filePath)
         return nullptr;
     }
 
-    return std::make_shared<EntityData>(entityData.value());
+    entityData->treeBytes = eDataSource->size() * JSON_TREE_BYTES_PER_SOURCE_BYTE;
+    return std::make_shared<EntityData>(std::move(entityData.value()));
+}
+
+void EntityLoader::references(const IAsset& asset, std::vector<AssetReference>& out) const {
+    auto& entityData = static_cast<const EntityData&>(asset);
+    auto components = entityData.data.find("components");
+    if(components == entityData.data.end() || !components->is_array()) {
+        return;
+    }
+
+    // mirrors what the entity creator hands to the components
+    for(auto& c : components.value()) {
+        auto type = c.find("type");
+        if(type == c.end() || !type->is_string()) {
+            continue;
+        }
+        if(*type == "spellbook") {
+            auto spells = c.find("spells");
+            if(spells == c.end() || !spells->is_array()) {
+                continue;
+            }
+            for(auto& s : spells.value()) {
+                if(s.is_string()) {
+                    out.push_back({typeid(SpellData), s.get<std::string>()});
+                }
+            }
+        } else if(*type == "geometry") {
+            auto texture = c.find("texture_path");
+            if(texture != c.end() && texture->is_string()) {
+                out.push_back({typeid(Texture), texture->get<std::string>()});
+            }
+        }
+    }
+}
+
+bool EntityLoader::cook(const IAsset& asset, BinaryWriter& writer) const {
+    // the blueprint stays a json tree for the entity creator, stored as CBOR it loads without
+    // any text parsing
+    auto& entityData = static_cast<const EntityData&>(asset);
+    std::vector<std::uint8_t> cbor = json::to_cbor(entityData.data);
+    writer.writeU32(static_cast<u32>(cbor.size()));
+    writer.writeBytes({reinterpret_cast<const char*>(cbor.data()), cbor.size()});
+    return true;
+}
+
+auto EntityLoader::loadCooked(AssetManager& assetManager, BinaryReader& reader) -> IAssetPtr {
+    u32 size = reader.readU32();
+    auto cbor = reader.readBytes(size);
+    if(!reader.ok()) {
+        return nullptr;
+    }
+
+    EntityData data;
+    try {
+        data.data = json::from_cbor(cbor.begin(), cbor.end());
+    } catch(const json::exception& e) {
+        ERROR("[ENTITY LOADER]: " + std::string(e.what()));
+        return nullptr;
+    }
+    data.treeBytes = cbor.size() * JSON_TREE_BYTES_PER_SOURCE_BYTE;
+    return std::make_shared<EntityData>(std::move(data));
+}
+
+auto EntityLoader::memoryUsage(const IAsset& asset) const -> size_t {
+    return sizeof(EntityData) + static_cast<const EntityData&>(asset).treeBytes;
 }
 
 auto EntityLoader::parseEntityData(const std::string& source)
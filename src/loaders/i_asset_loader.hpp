@@ -3,9 +3,62 @@
 #include "../utils.hpp"
 
 class AssetManager;
+class BinaryReader;
+class BinaryWriter;
+
+/// A file an asset refers to, see AssetManager::prefetch.
+struct AssetReference {
+    std::type_index type;
+    std::string path;
+};
 
 class IAssetLoader {
 public:
     virtual ~IAssetLoader() = default;
     virtual auto load(AssetManager& assetManager, const std::string& assetPath) -> IAssetPtr = 0;
+
+    /// Loaders creating GPU resources split asynchronous loads in two. decode does the file I/O
+    /// and decoding on a worker, upload turns its result into the asset on the render thread.
+    virtual bool needsUpload() const {
+        return false;
+    }
+    virtual auto decode(AssetManager& assetManager, const std::string& assetPath) -> IAssetPtr {
+        return load(assetManager, assetPath);
+    }
+    /// decode for a file the caller already read. Loaders that only decode files read it again.
+    virtual auto decode(
+        AssetManager& assetManager, const std::string& assetPath, std::span<const char> bytes)
+        -> IAssetPtr {
+        return decode(assetManager, assetPath);
+    }
+    virtual auto upload(IAssetPtr decoded) -> IAssetPtr {
+        return decoded;
+    }
+
+    /// Appends the files a loaded asset refers to, which components would otherwise only load
+    /// once they attach.
+    virtual void references(const IAsset& asset, std::vector<AssetReference>& out) const {
+    }
+
+    /// Writes a parsed asset, the decoded one for upload loaders, as a binary record. Loading it
+    /// back skips all text parsing and image decoding. Loaders without a cooked format return
+    /// false and keep loading their source files.
+    virtual bool cook(const IAsset& asset, BinaryWriter& writer) const {
+        return false;
+    }
+    /// Bytes a loaded asset occupies, in memory or on the GPU, for the cache's memory budget.
+    /// Assets reporting 0 are never evicted.
+    virtual auto memoryUsage(const IAsset& asset) const -> size_t {
+        return 0;
+    }
+
+    /// Called by AssetManager::update on the render thread, loaders free the GPU resources of
+    /// evicted assets here.
+    virtual void update() {
+    }
+
+    /// Reads what cook wrote, in place of load, or of decode for upload loaders.
+    virtual auto loadCooked(AssetManager& assetManager, BinaryReader& reader) -> IAssetPtr {
+        return nullptr;
+    }
 };
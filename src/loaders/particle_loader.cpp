@@ -1,6 +1,8 @@
 #include "particle_loader.hpp"
 
+#include "../binary_io.hpp"
 #include "../file_io.hpp"
+#include "../texture.hpp"
 
 auto ParticleLoader::load(AssetManager& assetManager, const std::string& filePath) -> IAssetPtr {
     auto particleSource = FileIO::readTextFile(filePath);
@@ -17,6 +19,47 @@ auto ParticleLoader::load(AssetManager& assetManager, const std::string& filePat
 
     return std::make_shared<ParticleData>(particle.value());
 }
+
+void ParticleLoader::references(const IAsset& asset, std::vector<AssetReference>& out) const {
+    auto& particle = static_cast<const ParticleData&>(asset);
+    out.push_back({typeid(Texture), particle.textureFilePath});
+}
+
+bool ParticleLoader::cook(const IAsset& asset, BinaryWriter& writer) const {
+    auto& particle = static_cast<const ParticleData&>(asset);
+    writer.writeString(particle.textureFilePath);
+    for(f32 value :
+        {particle.minLifeTime, particle.maxLifeTime, particle.minStartScale,
+         particle.maxStartScale, particle.minEndScale, particle.maxEndScale,
+         particle.minStartAlpha, particle.maxStartAlpha, particle.minEndAlpha,
+         particle.maxEndAlpha, particle.minSpeed, particle.maxSpeed,
+         particle.minAngularVelocity, particle.maxAngularVelocity}) {
+        writer.writeF32(value);
+    }
+    return true;
+}
+
+auto ParticleLoader::loadCooked(AssetManager& assetManager, BinaryReader& reader) -> IAssetPtr {
+    ParticleData particle;
+    particle.textureFilePath = reader.readString();
+    for(f32* value :
+        {&particle.minLifeTime, &particle.maxLifeTime, &particle.minStartScale,
+         &particle.maxStartScale, &particle.minEndScale, &particle.maxEndScale,
+         &particle.minStartAlpha, &particle.maxStartAlpha, &particle.minEndAlpha,
+         &particle.maxEndAlpha, &particle.minSpeed, &particle.maxSpeed,
+         &particle.minAngularVelocity, &particle.maxAngularVelocity}) {
+        *value = reader.readF32();
+    }
+    if(!reader.ok()) {
+        return nullptr;
+    }
+    return std::make_shared<ParticleData>(particle);
+}
+
+auto ParticleLoader::memoryUsage(const IAsset& asset) const -> size_t {
+    return sizeof(ParticleData);
+}
+
 auto ParticleLoader::parseParticle(const std::string& source)
     -> std::expected<ParticleData, JSONParserError> {
     json particleJSON;
@@ -3,93 +3,83 @@
 #include <magic_enum/magic_enum.hpp>
 
 #include "../asset_manager.hpp"
-#include "../file_io.hpp"
-#include "../math.hpp"
+#include "../components/tilemap.hpp"
 #include "../scene.hpp"
+#include "scene_stream_parser.hpp"
 
 auto SceneLoader::load(AssetManager& assetManager, const std::string& filePath) -> IAssetPtr {
-    auto sceneSource = FileIO::readTextFile(filePath);
-    if(!sceneSource) {
-        ERROR(error(filePath + " " + sceneSource.error().message()));
-        return nullptr;
-    }
-
-    auto scene = parseScene(assetManager, sceneSource.value());
-    if(!scene) {
-        ERROR(error(filePath + " failed to parse"));
-        return nullptr;
-    }
-
-    return scene.value();
-}
-
-auto SceneLoader::parseScene(AssetManager& assetManager, const std::string& source)
-    -> std::expected<std::shared_ptr<Scene>, JSONParserError> {
-    json sceneJSON;
-    try {
-        sceneJSON = json::parse(source);
-    } catch(const json::exception& e) {
-        ERROR(error(std::string(e.what())));
-        return std::unexpected(JSONParserError::PARSE);
-    }
-
-    std::string sceneName;
-    if(!get<std::string>(sceneJSON, "name", true, sceneName, "")) {
-        return std::unexpected(JSONParserError::PARSE);
-    }
-
-    auto scene = Scene::create(sceneName, true /* lazyAttach */);
-
-    // go through entities
-    json::const_iterator entitiesJSON = sceneJSON.find("entities");
-    if(entitiesJSON == sceneJSON.end()) {
-        ERROR(error("has no entitites"));
-        return std::unexpected(JSONParserError::PARSE);
-    }
+    std::shared_ptr<Scene> scene;
 
-    for(auto& e : entitiesJSON.value()) {
-        std::string entityName;
-        std::string prefab;
-        Transform transform;
+    auto onHeader = [&](const SceneHeader& header) {
+        scene = Scene::create(header.name, true /* lazyAttach */);
 
-        if(!get<std::string>(e, "name", true, entityName, "entities")) {
-            return std::unexpected(JSONParserError::PARSE);
+        if(header.chunkSize > 0.0f || !header.chunkDirectory.empty()) {
+            if(header.chunkSize <= 0.0f || header.chunkDirectory.empty()) {
+                ERROR(error("streamed scenes need both chunkSize and chunks"));
+                return false;
+            }
+            scene->enableStreaming(header.chunkSize, header.chunkDirectory);
         }
 
-        if(!get<std::string>(e, "prefab", true, prefab, "entities")) {
-            return std::unexpected(JSONParserError::PARSE);
+        // optional ground layer
+        if(header.terrainFile.empty()) {
+            return true;
         }
-
-        json transformJSON;
-        if(!e.contains("transform")) {
-            ERROR(error("has no trasform", "entitites"));
-            return std::unexpected(JSONParserError::PARSE);
+        auto tilemap = assetManager.load<TilemapData>(header.terrainFile);
+        if(!tilemap) {
+            ERROR(error("failed to load terrain " + header.terrainFile));
+            return false;
         }
-        transformJSON = e["transform"];
-
-        if(transformJSON.is_array() && transformJSON.size() == 3) {
-            transform.position.x = transformJSON[0];
-            transform.position.y = transformJSON[1];
-            f32 angleInDegrees = transformJSON[2];
-            transform.rotation = math::radians(angleInDegrees);
-        } else {
-            ERROR(error("transform is invalid", "entitites"));
-            return std::unexpected(JSONParserError::PARSE);
+        auto tilemapComponent = std::make_shared<TilemapComponent>();
+        tilemapComponent->setTilemap(tilemap);
+        scene->addComponent(tilemapComponent);
+        return true;
+    };
+
+    // entities are only created by Scene::instantiate, the prefabs are loaded here so a missing
+    // one still fails the scene
+    auto onEntity = [&](const SceneEntityRecord& record) {
+        auto entitySource = assetManager.load<EntityData>(record.prefab);
+        if(!entitySource) {
+            return false;
         }
+        scene->queueEntity({record.name, record.prefab, entitySource, record.transform});
+        return true;
+    };
 
-        auto entitySource = assetManager.load<EntityData>(prefab);
-        if(!entitySource) {
-            return std::unexpected(JSONParserError::PARSE);
+    SceneStreamParser parser(onHeader, onEntity);
+    if(!parser.parse(filePath)) {
+        ERROR(error(filePath + " failed to parse - " + parser.error()));
+        return nullptr;
+    }
+    return scene;
+}
+
+auto SceneLoader::sceneReferences(const std::string& filePath) -> std::vector<AssetReference> {
+    std::vector<AssetReference> references;
+    auto am = AssetManager::get();
+
+    auto onHeader = [&](const SceneHeader& header) {
+        if(!header.terrainFile.empty()) {
+            references.push_back({typeid(TilemapData), header.terrainFile});
         }
-        auto entity = scene->entityCreator().createEntity(entityName, entitySource);
-        if(!entity) {
-            ERROR(error("failed to parse entity " + prefab));
-            return nullptr;
+        return true;
+    };
+
+    // prefabs are shared, most scenes list the same ones over and over
+    std::unordered_set<u32> prefabs;
+    auto onEntity = [&](const SceneEntityRecord& record) {
+        if(prefabs.insert(record.prefab.id).second) {
+            references.push_back({typeid(EntityData), am->path(record.prefab)});
         }
-        entity->setTransform(transform);
-        scene->addChild(entity);
+        return true;
+    };
+
+    SceneStreamParser parser(onHeader, onEntity);
+    if(!parser.parse(filePath)) {
+        ERROR(error(filePath + " failed to parse - " + parser.error()));
     }
-    return scene;
+    return references;
 }
 
 auto SceneLoader::error(const std::string& msg, const std::string& parent) const -> std::string {
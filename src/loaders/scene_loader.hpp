@@ -4,13 +4,15 @@
 #include "i_asset_loader.hpp"
 #include "json_parser.hpp"
 
+/// Scenes are streamed, see SceneStreamParser, every entity is queued on the scene as soon as it
+/// was read. Scene::instantiate creates them.
 class SceneLoader : public IAssetLoader, JSONParser {
 public:
     auto load(AssetManager& assetManager, const std::string& filePath) -> IAssetPtr override;
+    /// The terrain and prefabs a scene file refers to, read without instantiating the scene.
+    auto sceneReferences(const std::string& filePath) -> std::vector<AssetReference>;
 
 private:
-    auto parseScene(AssetManager& assetManager, const std::string& source)
-        -> std::expected<std::shared_ptr<Scene>, JSONParserError>;
     auto error(const std::string& msg, const std::string& parent = "") const
         -> std::string override;
 };
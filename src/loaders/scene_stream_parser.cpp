@@ -0,0 +1,283 @@
+#include "scene_stream_parser.hpp"
+
+#include <fstream>
+
+#include "../asset_manager.hpp"
+
+// nesting of the values the parser looks at, anything deeper is ignored
+const u32 SCENE_DEPTH = 1;
+const u32 ENTITIES_DEPTH = 2;
+const u32 ENTITY_DEPTH = 3;
+const u32 TRANSFORM_DEPTH = 4;
+// position x, position y and rotation in degrees
+const u32 TRANSFORM_VALUE_COUNT = 3;
+
+SceneStreamParser::SceneStreamParser(HeaderCallback onHeader, EntityCallback onEntity)
+    : onHeader_(std::move(onHeader)), onEntity_(std::move(onEntity)) {
+}
+
+bool SceneStreamParser::parse(const std::string& filePath) {
+    std::ifstream file(filePath, std::ios::in | std::ios::binary);
+    if(!file.is_open()) {
+        error_ = "failed to open " + filePath;
+        return false;
+    }
+    // reads the file in chunks, nothing but the current token is held in memory
+    return json::sax_parse(file, this);
+}
+
+auto SceneStreamParser::error() const -> const std::string& {
+    return error_;
+}
+
+bool SceneStreamParser::null() {
+    return skipsScalar() || fail(key_ + " is null");
+}
+
+bool SceneStreamParser::boolean(bool value) {
+    return skipsScalar() || fail(key_ + " is a boolean");
+}
+
+bool SceneStreamParser::number_integer(number_integer_t value) {
+    return skipsScalar() || number(static_cast<f32>(value));
+}
+
+bool SceneStreamParser::number_unsigned(number_unsigned_t value) {
+    return skipsScalar() || number(static_cast<f32>(value));
+}
+
+bool SceneStreamParser::number_float(number_float_t value, const string_t& text) {
+    return skipsScalar() || number(static_cast<f32>(value));
+}
+
+bool SceneStreamParser::string(string_t& value) {
+    if(skipsScalar()) {
+        return true;
+    }
+
+    switch(field_) {
+        case Field::SCENE_NAME:
+            header_.name = std::move(value);
+            break;
+        case Field::TERRAIN:
+            header_.terrainFile = std::move(value);
+            break;
+        case Field::CHUNK_DIRECTORY:
+            header_.chunkDirectory = std::move(value);
+            break;
+        case Field::ENTITY_NAME:
+            entity_.name = std::move(value);
+            hasName_ = true;
+            break;
+        case Field::PREFAB:
+            prefab_ = std::move(value);
+            break;
+        default:
+            return fail(key_ + " is a string");
+    }
+    field_ = Field::NONE;
+    return true;
+}
+
+bool SceneStreamParser::binary(binary_t& value) {
+    return skipsScalar() || fail(key_ + " is binary");
+}
+
+bool SceneStreamParser::start_object(size_t elements) {
+    depth_++;
+    if(skipsOpening()) {
+        return true;
+    }
+
+    if(depth_ == SCENE_DEPTH) {
+        return true;
+    }
+    if(depth_ == ENTITY_DEPTH && inEntities_) {
+        entity_ = {};
+        prefab_.clear();
+        hasName_ = false;
+        hasTransform_ = false;
+        return true;
+    }
+    return fail(key_ + " is an object");
+}
+
+bool SceneStreamParser::key(string_t& key) {
+    if(skipDepth_ != 0) {
+        return true;
+    }
+
+    key_ = key;
+    field_ = Field::NONE;
+    if(depth_ == SCENE_DEPTH) {
+        if(key == "name") {
+            field_ = Field::SCENE_NAME;
+        } else if(key == "terrain") {
+            field_ = Field::TERRAIN;
+        } else if(key == "chunkSize") {
+            field_ = Field::CHUNK_SIZE;
+        } else if(key == "chunks") {
+            field_ = Field::CHUNK_DIRECTORY;
+        } else if(key == "entities") {
+            field_ = Field::ENTITIES;
+        }
+        if(headerReported_ && field_ != Field::NONE) {
+            return fail(key + " has to come before the entities");
+        }
+    } else if(depth_ == ENTITY_DEPTH) {
+        if(key == "name") {
+            field_ = Field::ENTITY_NAME;
+        } else if(key == "prefab") {
+            field_ = Field::PREFAB;
+        } else if(key == "transform") {
+            field_ = Field::TRANSFORM;
+        }
+    }
+    skipNext_ = field_ == Field::NONE;
+    return true;
+}
+
+bool SceneStreamParser::end_object() {
+    if(skipsClosing()) {
+        return true;
+    }
+
+    bool ok = true;
+    if(depth_ == ENTITY_DEPTH) {
+        ok = finishEntity();
+    } else if(depth_ == SCENE_DEPTH && !headerReported_) {
+        ok = fail("has no entities");
+    }
+    depth_--;
+    return ok;
+}
+
+bool SceneStreamParser::start_array(size_t elements) {
+    depth_++;
+    if(skipsOpening()) {
+        return true;
+    }
+
+    if(depth_ == ENTITIES_DEPTH && field_ == Field::ENTITIES) {
+        field_ = Field::NONE;
+        inEntities_ = true;
+        return reportHeader();
+    }
+    if(depth_ == TRANSFORM_DEPTH && field_ == Field::TRANSFORM) {
+        transformValues_ = 0;
+        return true;
+    }
+    return fail(key_ + " is an array");
+}
+
+bool SceneStreamParser::end_array() {
+    if(skipsClosing()) {
+        return true;
+    }
+
+    bool ok = true;
+    if(depth_ == TRANSFORM_DEPTH) {
+        field_ = Field::NONE;
+        hasTransform_ = transformValues_ == TRANSFORM_VALUE_COUNT;
+        ok = hasTransform_ || fail("transform is invalid in " + entity_.name);
+    } else if(depth_ == ENTITIES_DEPTH) {
+        inEntities_ = false;
+    }
+    depth_--;
+    return ok;
+}
+
+bool SceneStreamParser::parse_error(
+    size_t position, const std::string& token, const json::exception& exception) {
+    error_ = exception.what();
+    return false;
+}
+
+bool SceneStreamParser::skipsOpening() {
+    if(skipDepth_ != 0) {
+        return true;
+    }
+    if(skipNext_) {
+        skipNext_ = false;
+        skipDepth_ = depth_;
+        return true;
+    }
+    return false;
+}
+
+bool SceneStreamParser::skipsClosing() {
+    if(skipDepth_ == 0) {
+        return false;
+    }
+    if(depth_ == skipDepth_) {
+        skipDepth_ = 0;
+    }
+    depth_--;
+    return true;
+}
+
+bool SceneStreamParser::skipsScalar() {
+    if(skipDepth_ != 0) {
+        return true;
+    }
+    if(skipNext_) {
+        skipNext_ = false;
+        return true;
+    }
+    return false;
+}
+
+bool SceneStreamParser::number(f32 value) {
+    if(field_ == Field::CHUNK_SIZE && depth_ == SCENE_DEPTH) {
+        field_ = Field::NONE;
+        header_.chunkSize = value;
+        return value > 0.0f || fail("chunkSize has to be positive");
+    }
+    if(field_ != Field::TRANSFORM || depth_ != TRANSFORM_DEPTH) {
+        return fail(key_ + " is a number");
+    }
+
+    switch(transformValues_) {
+        case 0:
+            entity_.transform.position.x = value;
+            break;
+        case 1:
+            entity_.transform.position.y = value;
+            break;
+        case 2:
+            entity_.transform.rotation = math::radians(value);
+            break;
+        default:
+            return fail("transform is invalid in " + entity_.name);
+    }
+    transformValues_++;
+    return true;
+}
+
+bool SceneStreamParser::fail(const std::string& message) {
+    error_ = message;
+    return false;
+}
+
+bool SceneStreamParser::reportHeader() {
+    headerReported_ = true;
+    if(header_.name.empty()) {
+        return fail("name not found");
+    }
+    return onHeader_(header_) || fail("failed to set up " + header_.name);
+}
+
+bool SceneStreamParser::finishEntity() {
+    if(!hasName_) {
+        return fail("name not found in entities");
+    }
+    if(prefab_.empty()) {
+        return fail("prefab not found in " + entity_.name);
+    }
+    if(!hasTransform_) {
+        return fail(entity_.name + " has no transform");
+    }
+
+    entity_.prefab = AssetManager::get()->intern(prefab_);
+    return onEntity_(entity_) || fail("failed to add entity " + entity_.name);
+}
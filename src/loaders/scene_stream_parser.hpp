@@ -0,0 +1,97 @@
+#pragma once
+
+#include "../asset_id.hpp"
+#include "../math.hpp"
+#include "json_parser.hpp"
+
+/// What a scene file says before its entities.
+struct SceneHeader {
+    std::string name;
+    std::string terrainFile;
+    /// Streamed scenes only, see WorldStreamer. 0 for scenes loaded as a whole.
+    f32 chunkSize{0.0f};
+    std::string chunkDirectory;
+};
+
+/// One entity of a scene file, all that is kept of it while reading.
+struct SceneEntityRecord {
+    std::string name;
+    AssetId prefab;
+    Transform transform;
+};
+
+/// Reads a scene file as a stream of SAX events and hands out each entity as soon as its object
+/// is complete, no json DOM is ever built. The header keys have to come before the entities, the
+/// header is reported once the entities start.
+class SceneStreamParser : public json::json_sax_t {
+public:
+    using HeaderCallback = std::function<bool(const SceneHeader& header)>;
+    /// Returning false stops the parse.
+    using EntityCallback = std::function<bool(const SceneEntityRecord& entity)>;
+
+    SceneStreamParser(HeaderCallback onHeader, EntityCallback onEntity);
+
+    /// Returns false on malformed files and when a callback failed, error() tells which.
+    bool parse(const std::string& filePath);
+    auto error() const -> const std::string&;
+
+public:
+    bool null() override;
+    bool boolean(bool value) override;
+    bool number_integer(number_integer_t value) override;
+    bool number_unsigned(number_unsigned_t value) override;
+    bool number_float(number_float_t value, const string_t& text) override;
+    bool string(string_t& value) override;
+    bool binary(binary_t& value) override;
+    bool start_object(size_t elements) override;
+    bool key(string_t& key) override;
+    bool end_object() override;
+    bool start_array(size_t elements) override;
+    bool end_array() override;
+    bool parse_error(
+        size_t position, const std::string& token, const json::exception& exception) override;
+
+private:
+    enum class Field {
+        NONE,
+        SCENE_NAME,
+        TERRAIN,
+        CHUNK_SIZE,
+        CHUNK_DIRECTORY,
+        ENTITIES,
+        ENTITY_NAME,
+        PREFAB,
+        TRANSFORM
+    };
+
+    bool skipsOpening();
+    bool skipsClosing();
+    bool skipsScalar();
+    bool number(f32 value);
+    bool fail(const std::string& message);
+    bool reportHeader();
+    bool finishEntity();
+
+private:
+    HeaderCallback onHeader_;
+    EntityCallback onEntity_;
+    std::string error_;
+
+    // nesting of the current event, the root object is depth 1
+    u32 depth_{0};
+    // the value after an unknown key is ignored, skipDepth_ is the depth of an ignored object or
+    // array, 0 while nothing is ignored
+    bool skipNext_{false};
+    u32 skipDepth_{0};
+    Field field_{Field::NONE};
+    std::string key_;
+    bool inEntities_{false};
+    bool headerReported_{false};
+
+    SceneHeader header_;
+    SceneEntityRecord entity_;
+    std::string prefab_;
+    u32 transformValues_{0};
+    bool hasName_{false};
+    bool hasTransform_{false};
+};
@@ -2,7 +2,18 @@
 
 #include <magic_enum/magic_enum.hpp>
 
+#include "../binary_io.hpp"
+#include "../components/animation.hpp"
+#include "../components/particle_system.hpp"
+#include "../components/status_effect.hpp"
+#include "../entity_data.hpp"
 #include "../file_io.hpp"
+#include "../texture.hpp"
+
+// how the motion of a spell action is tagged in cooked spells
+const u8 COOKED_NO_MOTION = 0;
+const u8 COOKED_CONSTANT_MOTION = 1;
+const u8 COOKED_INSTANT_MOTION = 2;
 
 auto SpellLoader::load(AssetManager& assetManager, const std::string& filePath) -> IAssetPtr {
     auto spellSource = FileIO::readTextFile(filePath);
@@ -20,6 +31,196 @@ auto SpellLoader::load(AssetManager& assetManager, const std::string& filePath)
     return std::make_shared<SpellData>(spell.value());
 }
 
+void SpellLoader::references(const IAsset& asset, std::vector<AssetReference>& out) const {
+    auto& spell = static_cast<const SpellData&>(asset);
+    out.push_back({typeid(Texture), spell.textureFilePath});
+    for(auto& [name, file] : spell.animationFiles) {
+        out.push_back({typeid(AnimationData), file});
+    }
+    for(auto& file : spell.emitterFiles) {
+        out.push_back({typeid(EmitterData), file});
+    }
+    for(auto& effect : spell.action.effects) {
+        if(effect.visual) {
+            out.push_back({typeid(StatusEffectData), effect.effectFilePath});
+        }
+    }
+    out.push_back({typeid(EntityData), spell.spawnPrefabFile});
+}
+
+bool SpellLoader::cook(const IAsset& asset, BinaryWriter& writer) const {
+    auto& spell = static_cast<const SpellData&>(asset);
+    writer.writeString(spell.name);
+    writer.writeF32(spell.castTime);
+    writer.writeF32(spell.interruptTime);
+    writer.writeU32(spell.manaCost);
+    writer.writeF32(spell.cooldown);
+    writer.writeF32(spell.duration);
+    writer.writeF32(spell.maxRange);
+    writer.writeString(spell.textureFilePath);
+
+    // action, the motion as a tag followed by its parameters
+    writer.writeEnum(spell.action.type);
+    writer.writeBool(spell.action.pierce);
+    if(auto constant = std::dynamic_pointer_cast<ConstantMotion>(spell.action.motion)) {
+        writer.writeU8(COOKED_CONSTANT_MOTION);
+        writer.writeF32(constant->speed);
+    } else if(std::dynamic_pointer_cast<InstantMotion>(spell.action.motion)) {
+        writer.writeU8(COOKED_INSTANT_MOTION);
+    } else {
+        writer.writeU8(COOKED_NO_MOTION);
+    }
+    writer.writeU32(static_cast<u32>(spell.action.effects.size()));
+    for(auto& effect : spell.action.effects) {
+        cookEffect(effect, writer);
+    }
+
+    writer.writeRect(spell.geometryData.rect);
+    writer.writeEnum(spell.geometryData.sizeDeterminant);
+
+    // the shape as its variant index followed by its values
+    writer.writeEnum(spell.collisionData.shape.shape());
+    std::visit(
+        overloaded{
+            [&](const Circle& circle) {
+                writer.writeF32(circle.x);
+                writer.writeF32(circle.y);
+                writer.writeF32(circle.r);
+            },
+            [&](const Line& line) {
+                writer.writeVec2(line.p1);
+                writer.writeVec2(line.p2);
+            },
+            [&](const Rect& rect) { writer.writeRect(rect); }},
+        spell.collisionData.shape);
+    writer.writeEnum(spell.collisionData.sizeDeterminant);
+
+    writer.writeU32(static_cast<u32>(spell.animationFiles.size()));
+    for(auto& [name, file] : spell.animationFiles) {
+        writer.writeString(name);
+        writer.writeString(file);
+    }
+    writer.writeU32(static_cast<u32>(spell.emitterFiles.size()));
+    for(auto& file : spell.emitterFiles) {
+        writer.writeString(file);
+    }
+    writer.writeU8(spell.componentRequirements);
+    writer.writeString(spell.spawnName);
+    writer.writeString(spell.spawnPrefabFile);
+    return true;
+}
+
+auto SpellLoader::loadCooked(AssetManager& assetManager, BinaryReader& reader) -> IAssetPtr {
+    SpellData spell;
+    spell.name = reader.readString();
+    spell.castTime = reader.readF32();
+    spell.interruptTime = reader.readF32();
+    spell.manaCost = reader.readU32();
+    spell.cooldown = reader.readF32();
+    spell.duration = reader.readF32();
+    spell.maxRange = reader.readF32();
+    spell.textureFilePath = reader.readString();
+
+    spell.action.type = reader.readEnum<ActionType>();
+    spell.action.pierce = reader.readBool();
+    u8 motion = reader.readU8();
+    if(motion == COOKED_CONSTANT_MOTION) {
+        ConstantMotion constant;
+        constant.speed = reader.readF32();
+        spell.action.motion = std::make_shared<ConstantMotion>(constant);
+    } else if(motion == COOKED_INSTANT_MOTION) {
+        spell.action.motion = std::make_shared<InstantMotion>();
+    }
+    u32 effectCount = reader.readU32();
+    for(u32 i = 0; i < effectCount && reader.ok(); i++) {
+        spell.action.effects.push_back(loadCookedEffect(reader));
+    }
+
+    spell.geometryData.rect = reader.readRect();
+    spell.geometryData.sizeDeterminant = reader.readEnum<GeometrySizeDeterminant>();
+
+    switch(reader.readEnum<Shape>()) {
+        case Shape::CIRCLE: {
+            Circle circle;
+            circle.x = reader.readF32();
+            circle.y = reader.readF32();
+            circle.r = reader.readF32();
+            spell.collisionData.shape = circle;
+            break;
+        }
+        case Shape::LINE: {
+            Line line;
+            line.p1 = reader.readVec2();
+            line.p2 = reader.readVec2();
+            spell.collisionData.shape = line;
+            break;
+        }
+        case Shape::RECT:
+            spell.collisionData.shape = reader.readRect();
+            break;
+    }
+    spell.collisionData.sizeDeterminant = reader.readEnum<CollisionSizeDeterminant>();
+
+    u32 animationCount = reader.readU32();
+    for(u32 i = 0; i < animationCount && reader.ok(); i++) {
+        std::string name = reader.readString();
+        spell.animationFiles[name] = reader.readString();
+    }
+    u32 emitterCount = reader.readU32();
+    for(u32 i = 0; i < emitterCount && reader.ok(); i++) {
+        spell.emitterFiles.push_back(reader.readString());
+    }
+    spell.componentRequirements = reader.readU8();
+    spell.spawnName = reader.readString();
+    spell.spawnPrefabFile = reader.readString();
+
+    if(!reader.ok()) {
+        return nullptr;
+    }
+    return std::make_shared<SpellData>(spell);
+}
+
+auto SpellLoader::memoryUsage(const IAsset& asset) const -> size_t {
+    return sizeof(SpellData);
+}
+
+void SpellLoader::cookEffect(const SpellEffect& effect, BinaryWriter& writer) const {
+    writer.writeString(effect.name);
+    writer.writeEnum(effect.type);
+    writer.writeF32(effect.currentDuration);
+    writer.writeF32(effect.maxDuration);
+    writer.writeEnum(effect.dmgType);
+    writer.writeEnum(effect.targetFaction);
+    writer.writeU32(effect.minValue);
+    writer.writeU32(effect.maxValue);
+    writer.writeU32(effect.periodicValue);
+    writer.writeF32(effect.magnitude);
+    writer.writeU32(effect.currentStacks);
+    writer.writeU32(effect.maxStacks);
+    writer.writeBool(effect.visual);
+    writer.writeString(effect.effectFilePath);
+}
+
+auto SpellLoader::loadCookedEffect(BinaryReader& reader) const -> SpellEffect {
+    SpellEffect effect;
+    effect.name = reader.readString();
+    effect.type = reader.readEnum<SpellEffectType>();
+    effect.currentDuration = reader.readF32();
+    effect.maxDuration = reader.readF32();
+    effect.dmgType = reader.readEnum<DamageType>();
+    effect.targetFaction = reader.readEnum<FactionType>();
+    effect.minValue = reader.readU32();
+    effect.maxValue = reader.readU32();
+    effect.periodicValue = reader.readU32();
+    effect.magnitude = reader.readF32();
+    effect.currentStacks = reader.readU32();
+    effect.maxStacks = reader.readU32();
+    effect.visual = reader.readBool();
+    effect.effectFilePath = reader.readString();
+    effect.effectAsset = AssetManager::get()->intern(effect.effectFilePath);
+    return effect;
+}
+
 auto SpellLoader::parseSpell(const std::string& source)
     -> std::expected<SpellData, JSONParserError> {
     json spellJSON;
@@ -317,6 +518,7 @@ auto SpellLoader::parseOnHitEffect(const json& o, const std::string& parent)
         if(!get<std::string>(o, "effect_path", true, onHitEffect.effectFilePath, parent)) {
             return std::unexpected(JSONParserError::PARSE);
         }
+        onHitEffect.effectAsset = AssetManager::get()->intern(onHitEffect.effectFilePath);
     }
     // optional
     get<u32>(o, "min_value", false, onHitEffect.minValue, parent);
@@ -367,6 +569,7 @@ auto SpellLoader::parseSelfEffect(const json& o, const std::string& parent)
         if(!get<std::string>(o, "effect_path", true, selfEffect.effectFilePath, parent)) {
             return std::unexpected(JSONParserError::PARSE);
         }
+        selfEffect.effectAsset = AssetManager::get()->intern(selfEffect.effectFilePath);
     }
     // optional
     get<u32>(o, "min_value", false, selfEffect.minValue, parent);
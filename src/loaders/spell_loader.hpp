@@ -8,8 +8,14 @@
 class SpellLoader : public IAssetLoader, JSONParser {
 public:
     auto load(AssetManager& assetManager, const std::string& filePath) -> IAssetPtr override;
+    void references(const IAsset& asset, std::vector<AssetReference>& out) const override;
+    bool cook(const IAsset& asset, BinaryWriter& writer) const override;
+    auto loadCooked(AssetManager& assetManager, BinaryReader& reader) -> IAssetPtr override;
+    auto memoryUsage(const IAsset& asset) const -> size_t override;
 
 private:
+    void cookEffect(const SpellEffect& effect, BinaryWriter& writer) const;
+    auto loadCookedEffect(BinaryReader& reader) const -> SpellEffect;
     auto parseSpell(const std::string& source) -> std::expected<SpellData, JSONParserError>;
     bool parseGeneralData(const json& o, SpellData& spell, const std::string& parent = "");
     bool parseAction(const json& o, SpellData& spell, const std::string& parent = "");
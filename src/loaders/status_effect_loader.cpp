@@ -1,7 +1,9 @@
 #include "status_effect_loader.hpp"
 
+#include "../components/animation.hpp"
 #include "../file_io.hpp"
 #include "../log.hpp"
+#include "../texture.hpp"
 
 auto StatusEffectLoader::load(AssetManager& assetManager, const std::string& filePath)
     -> IAssetPtr {
@@ -20,6 +22,18 @@ auto StatusEffectLoader::load(AssetManager& assetManager, const std::string& fil
     return std::make_shared<StatusEffectData>(statusEffect.value());
 }
 
+void StatusEffectLoader::references(const IAsset& asset, std::vector<AssetReference>& out) const {
+    auto& effect = static_cast<const StatusEffectData&>(asset);
+    out.push_back({typeid(Texture), effect.textureFilePath});
+    for(auto& [name, file] : effect.animationFiles) {
+        out.push_back({typeid(AnimationData), file});
+    }
+}
+
+auto StatusEffectLoader::memoryUsage(const IAsset& asset) const -> size_t {
+    return sizeof(StatusEffectData);
+}
+
 auto StatusEffectLoader::parseStatusEffect(const std::string& source)
     -> std::expected<StatusEffectData, JSONParserError> {
     json statusEffectJSON;
@@ -8,6 +8,8 @@
 class StatusEffectLoader : public IAssetLoader, JSONParser {
 public:
     auto load(AssetManager& assetManager, const std::string& filePath) -> IAssetPtr override;
+    void references(const IAsset& asset, std::vector<AssetReference>& out) const override;
+    auto memoryUsage(const IAsset& asset) const -> size_t override;
 
 private:
     auto parseStatusEffect(const std::string& source)
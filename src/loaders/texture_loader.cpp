@@ -2,27 +2,155 @@
 
 #include <SDL3_image/SDL_image.h>
 
+#include <algorithm>
+
+#include "../binary_io.hpp"
 #include "../log.hpp"
 #include "../renderer.hpp"
 
-TextureLoader::TextureLoader(std::shared_ptr<Renderer> renderer) : renderer_(renderer) {
+const size_t TEXTURE_BYTES_PER_PIXEL = 4;
+// larger than any GPU takes, a cooked size beyond it is a corrupt blob
+const u32 MAX_TEXTURE_DIMENSION = 16384;
+
+DecodedImage::~DecodedImage() {
+    if(surface) {
+        SDL_DestroySurface(surface);
+    }
+}
+
+TextureLoader::TextureLoader(std::shared_ptr<Renderer> renderer)
+    : renderer_(renderer), atlas_(std::make_shared<TextureAtlas>()) {
 }
 
 auto TextureLoader::load(AssetManager& assetManager, const std::string& assetPath) -> IAssetPtr {
+    auto decoded = decode(assetManager, assetPath);
+    if(!decoded) {
+        return nullptr;
+    }
+    return upload(decoded);
+}
+
+bool TextureLoader::needsUpload() const {
+    return true;
+}
+
+auto TextureLoader::decode(AssetManager& assetManager, const std::string& assetPath)
+    -> IAssetPtr {
+    SDL_Surface* surface = IMG_Load(assetPath.c_str());
+    if(!surface) {
+        std::string error = SDL_GetError();
+        ERROR("[TEXTURE LOADER]: " + error);
+        return nullptr;
+    }
+
+    auto image = std::make_shared<DecodedImage>();
+    image->surface = surface;
+    return image;
+}
+
+auto TextureLoader::decode(
+    AssetManager& assetManager, const std::string& assetPath, std::span<const char> bytes)
+    -> IAssetPtr {
+    // the stream is closed by the load, the bytes stay with the caller
+    SDL_IOStream* stream = SDL_IOFromConstMem(bytes.data(), bytes.size());
+    SDL_Surface* surface = stream ? IMG_Load_IO(stream, true) : nullptr;
+    if(!surface) {
+        std::string error = SDL_GetError();
+        ERROR("[TEXTURE LOADER]: " + assetPath + " - " + error);
+        return nullptr;
+    }
+
+    auto image = std::make_shared<DecodedImage>();
+    image->surface = surface;
+    return image;
+}
+
+auto TextureLoader::upload(IAssetPtr decoded) -> IAssetPtr {
     auto renderer = renderer_.lock();
     if(!renderer) {
         ERROR("[TEXTURE LOADER]: failed to access renderer handle to load texture");
         return nullptr;
     }
 
-    SDL_Texture* texture = IMG_LoadTexture(renderer->handle(), assetPath.c_str());
-    if(!texture) {
+    auto image = std::static_pointer_cast<DecodedImage>(decoded);
+    auto result = std::make_shared<Texture>();
+
+    // sprites share atlas pages so the renderer can batch across them, anything too large gets a
+    // texture of its own
+    auto region = atlas_->insert(renderer->handle(), image->surface);
+    if(region) {
+        result->setAtlasRegion(region->page, region->rect);
+    } else {
+        SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer->handle(), image->surface);
+        if(!texture) {
+            std::string error = SDL_GetError();
+            ERROR("[TEXTURE LOADER]: " + error);
+            return nullptr;
+        }
+        result->setTexture(texture);
+    }
+    result->releaseTo(atlas_);
+    return result;
+}
+
+bool TextureLoader::cook(const IAsset& asset, BinaryWriter& writer) const {
+    auto& image = static_cast<const DecodedImage&>(asset);
+    SDL_Surface* rgba = SDL_ConvertSurface(image.surface, SDL_PIXELFORMAT_RGBA32);
+    if(!rgba) {
+        std::string error = SDL_GetError();
+        ERROR("[TEXTURE LOADER]: " + error);
+        return false;
+    }
+
+    // rows are written tightly packed, the surface pitch may pad them
+    u32 rowSize = static_cast<u32>(rgba->w) * 4;
+    writer.writeU32(static_cast<u32>(rgba->w));
+    writer.writeU32(static_cast<u32>(rgba->h));
+    for(s32 y = 0; y < rgba->h; y++) {
+        auto row = static_cast<const char*>(rgba->pixels) + y * rgba->pitch;
+        writer.writeBytes({row, rowSize});
+    }
+    SDL_DestroySurface(rgba);
+    return true;
+}
+
+auto TextureLoader::loadCooked(AssetManager& assetManager, BinaryReader& reader) -> IAssetPtr {
+    u32 width = reader.readU32();
+    u32 height = reader.readU32();
+    if(!reader.ok() || width == 0 || height == 0 || width > MAX_TEXTURE_DIMENSION ||
+       height > MAX_TEXTURE_DIMENSION) {
+        return nullptr;
+    }
+    // at most 1 GiB within the bounds, the reader checks it against the blob
+    size_t rowSize = width * TEXTURE_BYTES_PER_PIXEL;
+    auto pixels = reader.readBytes(static_cast<u32>(rowSize * height));
+    if(!reader.ok()) {
+        return nullptr;
+    }
+
+    SDL_Surface* surface = SDL_CreateSurface(
+        static_cast<s32>(width), static_cast<s32>(height), SDL_PIXELFORMAT_RGBA32);
+    if(!surface) {
         std::string error = SDL_GetError();
         ERROR("[TEXTURE LOADER]: " + error);
         return nullptr;
     }
-    Texture result;
-    result.setTexture(texture);
+    for(size_t y = 0; y < height; y++) {
+        std::copy_n(
+            pixels.data() + y * rowSize, rowSize,
+            static_cast<char*>(surface->pixels) + y * static_cast<size_t>(surface->pitch));
+    }
+
+    auto image = std::make_shared<DecodedImage>();
+    image->surface = surface;
+    return image;
+}
+
+void TextureLoader::update() {
+    atlas_->destroyReleased();
+}
 
-    return std::make_shared<Texture>(result);
+auto TextureLoader::memoryUsage(const IAsset& asset) const -> size_t {
+    auto size = static_cast<const Texture&>(asset).size();
+    return static_cast<size_t>(size.x) * static_cast<size_t>(size.y) * TEXTURE_BYTES_PER_PIXEL;
 }
@@ -1,17 +1,43 @@
 #pragma once
 
+#include "../i_asset.hpp"
 #include "../texture.hpp"
+#include "../texture_atlas.hpp"
 #include "i_asset_loader.hpp"
 
 class AssetManager;
 class Renderer;
 
+/// An image decoded on a worker, waiting for its upload.
+struct DecodedImage : IAsset {
+    ~DecodedImage();
+    SDL_Surface* surface{nullptr};
+};
+
 class TextureLoader : public IAssetLoader {
 public:
     TextureLoader(std::shared_ptr<Renderer> renderer);
 
     auto load(AssetManager& assetManager, const std::string& assetPath) -> IAssetPtr;
 
+    bool needsUpload() const override;
+    /// any thread
+    auto decode(AssetManager& assetManager, const std::string& assetPath) -> IAssetPtr override;
+    auto decode(
+        AssetManager& assetManager, const std::string& assetPath, std::span<const char> bytes)
+        -> IAssetPtr override;
+    /// render thread
+    auto upload(IAssetPtr decoded) -> IAssetPtr override;
+    /// Cooked textures are raw RGBA32 pixels, loading them skips the PNG decode.
+    bool cook(const IAsset& asset, BinaryWriter& writer) const override;
+    auto loadCooked(AssetManager& assetManager, BinaryReader& reader) -> IAssetPtr override;
+    /// Counts the texels of the texture's region at 32 bits each, the format of the atlas pages.
+    auto memoryUsage(const IAsset& asset) const -> size_t override;
+    /// Frees the atlas pages and textures of evicted textures.
+    void update() override;
+
 private:
     std::weak_ptr<Renderer> renderer_;
+    // shared with the textures, which give their space back when they are evicted
+    std::shared_ptr<TextureAtlas> atlas_;
 };
@@ -0,0 +1,116 @@
+#include "tilemap_loader.hpp"
+
+#include <atomic>
+
+#include "../file_io.hpp"
+#include "../texture.hpp"
+
+auto TilemapLoader::load(AssetManager& assetManager, const std::string& filePath) -> IAssetPtr {
+    auto tilemapSource = FileIO::readTextFile(filePath);
+    if(!tilemapSource) {
+        ERROR(error(filePath + " " + tilemapSource.error().message()));
+        return nullptr;
+    }
+
+    auto tilemap = parseTilemap(tilemapSource.value());
+    if(!tilemap) {
+        ERROR(error(filePath + " failed to parse"));
+        return nullptr;
+    }
+
+    return std::make_shared<TilemapData>(tilemap.value());
+}
+
+void TilemapLoader::references(const IAsset& asset, std::vector<AssetReference>& out) const {
+    auto& tilemap = static_cast<const TilemapData&>(asset);
+    out.push_back({typeid(Texture), tilemap.tilesetFilePath});
+}
+
+auto TilemapLoader::memoryUsage(const IAsset& asset) const -> size_t {
+    auto& tilemap = static_cast<const TilemapData&>(asset);
+    return sizeof(TilemapData) + tilemap.tiles.capacity() * sizeof(s32) +
+           tilemap.emptyChunks.capacity() / 8;
+}
+
+auto TilemapLoader::parseTilemap(const std::string& source)
+    -> std::expected<TilemapData, JSONParserError> {
+    json tilemapJSON;
+
+    try {
+        tilemapJSON = json::parse(source);
+    } catch(const json::exception& e) {
+        ERROR(error(std::string(e.what())));
+        return std::unexpected(JSONParserError::PARSE);
+    }
+
+    TilemapData tilemap;
+
+    if(!get<std::string>(tilemapJSON, "tileset", true, tilemap.tilesetFilePath)) {
+        return std::unexpected(JSONParserError::PARSE);
+    }
+
+    if(!get<u32>(tilemapJSON, "tile_size", true, tilemap.tileSize)) {
+        return std::unexpected(JSONParserError::PARSE);
+    }
+
+    if(!get<u32>(tilemapJSON, "width", true, tilemap.width)) {
+        return std::unexpected(JSONParserError::PARSE);
+    }
+
+    if(!get<u32>(tilemapJSON, "height", true, tilemap.height)) {
+        return std::unexpected(JSONParserError::PARSE);
+    }
+
+    if(tilemap.tileSize == 0) {
+        ERROR(error("tile_size has to be positive"));
+        return std::unexpected(JSONParserError::PARSE);
+    }
+
+    json::const_iterator tilesJSON = tilemapJSON.find("tiles");
+    if(tilesJSON == tilemapJSON.end() || !tilesJSON->is_array()) {
+        ERROR(error("tiles not found"));
+        return std::unexpected(JSONParserError::PARSE);
+    }
+
+    if(tilesJSON->size() != static_cast<size_t>(tilemap.width) * tilemap.height) {
+        ERROR(error("tiles does not match width * height"));
+        return std::unexpected(JSONParserError::PARSE);
+    }
+
+    tilemap.tiles.reserve(tilesJSON->size());
+    for(auto& tile : tilesJSON.value()) {
+        if(!tile.is_number_integer()) {
+            ERROR(error("tile is a " + std::string(tile.type_name()) + ", expected int", "tiles"));
+            return std::unexpected(JSONParserError::PARSE);
+        }
+        tilemap.tiles.push_back(tile.get<s32>());
+    }
+
+    // chunks without a single tile are skipped entirely when rendering
+    tilemap.chunkColumns = (tilemap.width + TILEMAP_CHUNK_SIZE - 1) / TILEMAP_CHUNK_SIZE;
+    tilemap.chunkRows = (tilemap.height + TILEMAP_CHUNK_SIZE - 1) / TILEMAP_CHUNK_SIZE;
+    tilemap.emptyChunks.assign(tilemap.chunkColumns * tilemap.chunkRows, true);
+    for(u32 y = 0; y < tilemap.height; y++) {
+        for(u32 x = 0; x < tilemap.width; x++) {
+            if(tilemap.tile(x, y) >= 0) {
+                u32 chunk =
+                    (y / TILEMAP_CHUNK_SIZE) * tilemap.chunkColumns + x / TILEMAP_CHUNK_SIZE;
+                tilemap.emptyChunks[chunk] = false;
+            }
+        }
+    }
+
+    static std::atomic<u32> nextId = 1;
+    tilemap.id = nextId++;
+    tilemap.tileset = TextureRegistry::get().acquire(tilemap.tilesetFilePath);
+
+    return tilemap;
+}
+
+auto TilemapLoader::error(const std::string& msg, const std::string& parent) const -> std::string {
+    std::string error = "[TILEMAP LOADER]: ";
+    if(!parent.empty()) {
+        error += '(' + parent + ") ";
+    }
+    return error + msg;
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+#include "../asset_manager.hpp"
+#include "../components/tilemap.hpp"
+#include "../utils.hpp"
+#include "json_parser.hpp"
+
+class TilemapLoader : public IAssetLoader, JSONParser {
+public:
+    auto load(AssetManager& assetManager, const std::string& filePath) -> IAssetPtr override;
+    void references(const IAsset& asset, std::vector<AssetReference>& out) const override;
+    auto memoryUsage(const IAsset& asset) const -> size_t override;
+
+private:
+    auto parseTilemap(const std::string& source) -> std::expected<TilemapData, JSONParserError>;
+    auto error(const std::string& msg, const std::string& parent = "") const
+        -> std::string override;
+};
@@ -0,0 +1,39 @@
+#include "world_chunk_loader.hpp"
+
+#include "../asset_manager.hpp"
+#include "scene_stream_parser.hpp"
+
+auto WorldChunkLoader::load(AssetManager& assetManager, const std::string& filePath)
+    -> IAssetPtr {
+    auto chunk = std::make_shared<WorldChunkData>();
+
+    auto onHeader = [](const SceneHeader& header) { return true; };
+    auto onEntity = [&](const SceneEntityRecord& record) {
+        auto entitySource = assetManager.load<EntityData>(record.prefab);
+        if(!entitySource) {
+            return false;
+        }
+        chunk->entities.push_back({record.name, record.prefab, entitySource, record.transform});
+        return true;
+    };
+
+    SceneStreamParser parser(onHeader, onEntity);
+    if(!parser.parse(filePath)) {
+        ERROR("[WORLD CHUNK LOADER]: " + filePath + " failed to parse - " + parser.error());
+        return nullptr;
+    }
+    return chunk;
+}
+
+void WorldChunkLoader::references(const IAsset& asset, std::vector<AssetReference>& out) const {
+    auto am = AssetManager::get();
+    for(auto& entity : static_cast<const WorldChunkData&>(asset).entities) {
+        out.push_back({typeid(EntityData), am->path(entity.prefab)});
+    }
+}
+
+auto WorldChunkLoader::memoryUsage(const IAsset& asset) const -> size_t {
+    // the prefabs are accounted for by their own entries
+    auto& chunk = static_cast<const WorldChunkData&>(asset);
+    return sizeof(WorldChunkData) + chunk.entities.size() * sizeof(QueuedEntity);
+}
@@ -0,0 +1,12 @@
+#pragma once
+
+#include "../world_chunk.hpp"
+#include "i_asset_loader.hpp"
+
+/// Chunk files are scene files, only their entities are used.
+class WorldChunkLoader : public IAssetLoader {
+public:
+    auto load(AssetManager& assetManager, const std::string& filePath) -> IAssetPtr override;
+    void references(const IAsset& asset, std::vector<AssetReference>& out) const override;
+    auto memoryUsage(const IAsset& asset) const -> size_t override;
+};
@@ -15,6 +15,9 @@ Log::~Log() {
 
 void Log::log(LogType type, const std::string& msg, const std::string& file,
     const std::string& function, u32 line, bool callOnce) {
+    // logged from the simulation and the render thread
+    std::lock_guard lock(mutex_);
+
     if(callOnce) {
         std::string cacheEntry = msg + file + function + std::to_string(line);
 
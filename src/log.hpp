@@ -3,6 +3,7 @@
 #include "utils.hpp"
 
 #include <fstream>
+#include <mutex>
 
 enum class LogType {
     INFO = 0,
@@ -27,6 +28,7 @@ public:
 private:
     std::fstream logFile_;
     std::unordered_set<std::string> logOnceCache_;
+    std::mutex mutex_;
 
 private:
     std::string currentDateTime();
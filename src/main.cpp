@@ -1,7 +1,83 @@
+#include <charconv>
+#include <limits>
+#include <optional>
+#include <string>
+
 #include "core.hpp"
+#include "log.hpp"
+#include "time.hpp"
+
+// far more steps per second than a tick keeps up with
+const u64 MAX_TICK_RATE = 10000;
+const u64 BYTES_PER_MIB = 1024 * 1024;
+
+namespace {
+	void printUsage() {
+		ERROR(
+			"usage: ces_test [--headless] [--realtime] [--ticks <count>] "
+			"[--tick-rate <per second>] [--capture <png>] [--hot-reload] "
+			"[--asset-budget <MiB>] [--pack <file>] [--scene <file>]");
+	}
+
+	// the whole argument has to be a number within [min, max]
+	auto parseNumber(const std::string& text, u64 min, u64 max) -> std::optional<u64> {
+		u64 value = 0;
+		auto end = text.data() + text.size();
+		auto [parsed, error] = std::from_chars(text.data(), end, value);
+		if(error != std::errc() || parsed != end || value < min || value > max) {
+			return std::nullopt;
+		}
+		return value;
+	}
+}
 
 int main(int argc, char const* argv[]) {
+	CoreOptions options;
+	for(int i = 1; i < argc; i++) {
+		std::string arg = argv[i];
+		bool hasValue = i + 1 < argc;
+		// simulation steps per second, rendering interpolates between them
+		if(arg == "--tick-rate" && hasValue) {
+			auto tickRate = parseNumber(argv[++i], 1, MAX_TICK_RATE);
+			if(!tickRate) {
+				ERROR("--tick-rate takes a number from 1 to " + std::to_string(MAX_TICK_RATE));
+				printUsage();
+				return 1;
+			}
+			Time::get().setTickRate(static_cast<u32>(*tickRate));
+		} else if(arg == "--headless") {
+			options.headless = true;
+		} else if(arg == "--realtime") {
+			options.realtime = true;
+		} else if(arg == "--ticks" && hasValue) {
+			auto ticks = parseNumber(argv[++i], 0, std::numeric_limits<u32>::max());
+			if(!ticks) {
+				ERROR("--ticks takes a step count, 0 runs until quit");
+				printUsage();
+				return 1;
+			}
+			options.ticks = static_cast<u32>(*ticks);
+		} else if(arg == "--capture" && hasValue) {
+			options.capturePath = argv[++i];
+		} else if(arg == "--hot-reload") {
+			options.hotReload = true;
+		} else if(arg == "--asset-budget" && hasValue) {
+			// in MiB, small enough that the bytes still fit
+			auto budget =
+				parseNumber(argv[++i], 0, std::numeric_limits<size_t>::max() / BYTES_PER_MIB);
+			if(!budget) {
+				ERROR("--asset-budget takes a size in MiB, 0 keeps every asset");
+				printUsage();
+				return 1;
+			}
+			options.assetMemoryBudget = static_cast<size_t>(*budget * BYTES_PER_MIB);
+		} else if(arg == "--pack" && hasValue) {
+			options.packPath = argv[++i];
+		} else if(arg == "--scene" && hasValue) {
+			options.sceneFile = argv[++i];
+		}
+	}
 
-	Core core;
+	Core core(options);
 	return core.run();
 }
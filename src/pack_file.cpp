@@ -0,0 +1,205 @@
+#include "pack_file.hpp"
+
+#ifdef _WIN32
+// keeps min/max usable and wingdi's ERROR from clashing with the log macro
+#define NOMINMAX
+#define NOGDI
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "binary_io.hpp"
+#include "file_io.hpp"
+#include "log.hpp"
+
+// "CESP", bump the version whenever the table of contents changes
+const u32 PACK_MAGIC = 0x50534543;
+const u32 PACK_VERSION = 1;
+// entries start on this boundary, so records can be read straight from the mapping
+const u32 PACK_ALIGNMENT = 16;
+
+namespace {
+    auto alignUp(size_t offset) -> size_t {
+        return (offset + PACK_ALIGNMENT - 1) / PACK_ALIGNMENT * PACK_ALIGNMENT;
+    }
+}
+
+PackFile::~PackFile() {
+    close();
+}
+
+bool PackFile::open(const std::string& filePath) {
+    close();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(
+        filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL, nullptr);
+    if(file == INVALID_HANDLE_VALUE) {
+        ERROR("[PACK FILE]: failed to open " + filePath);
+        return false;
+    }
+    file_ = file;
+
+    LARGE_INTEGER size;
+    if(!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+        ERROR("[PACK FILE]: " + filePath + " is empty");
+        close();
+        return false;
+    }
+    size_ = static_cast<size_t>(size.QuadPart);
+
+    mapping_ = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if(!mapping_) {
+        ERROR("[PACK FILE]: failed to map " + filePath);
+        close();
+        return false;
+    }
+    data_ = static_cast<const std::byte*>(MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+#else
+    file_ = ::open(filePath.c_str(), O_RDONLY);
+    if(file_ < 0) {
+        ERROR("[PACK FILE]: failed to open " + filePath);
+        return false;
+    }
+
+    struct stat status;
+    if(fstat(file_, &status) != 0 || status.st_size == 0) {
+        ERROR("[PACK FILE]: " + filePath + " is empty");
+        close();
+        return false;
+    }
+    size_ = static_cast<size_t>(status.st_size);
+
+    void* mapped = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, file_, 0);
+    data_ = mapped == MAP_FAILED ? nullptr : static_cast<const std::byte*>(mapped);
+#endif
+
+    if(!data_) {
+        ERROR("[PACK FILE]: failed to map " + filePath);
+        close();
+        return false;
+    }
+
+    if(!readTableOfContents()) {
+        ERROR("[PACK FILE]: " + filePath + " is not a pack of the current version");
+        close();
+        return false;
+    }
+
+    INFO(
+        "[PACK FILE]: opened " + filePath + " with " + std::to_string(entries_.size()) +
+        " entries");
+    return true;
+}
+
+void PackFile::close() {
+    entries_.clear();
+
+#ifdef _WIN32
+    if(data_) {
+        UnmapViewOfFile(data_);
+    }
+    if(mapping_) {
+        CloseHandle(mapping_);
+        mapping_ = nullptr;
+    }
+    if(file_) {
+        CloseHandle(file_);
+        file_ = nullptr;
+    }
+#else
+    if(data_) {
+        munmap(const_cast<std::byte*>(data_), size_);
+    }
+    if(file_ >= 0) {
+        ::close(file_);
+        file_ = -1;
+    }
+#endif
+
+    data_ = nullptr;
+    size_ = 0;
+}
+
+bool PackFile::isOpen() const {
+    return data_ != nullptr;
+}
+
+auto PackFile::find(const std::string& assetPath) const -> std::span<const std::byte> {
+    if(auto it = entries_.find(assetPath); it != entries_.end()) {
+        return it->second;
+    }
+    return {};
+}
+
+bool PackFile::contains(const std::string& assetPath) const {
+    return entries_.contains(assetPath);
+}
+
+bool PackFile::write(const std::string& filePath, const std::vector<PackEntry>& entries) {
+    // offsets are fixed size, so the table of contents can be measured before it is written
+    size_t tableSize = 3 * sizeof(u32);
+    for(auto& entry : entries) {
+        tableSize += sizeof(u32) + entry.path.size() + 2 * sizeof(u32);
+    }
+
+    std::vector<u32> offsets;
+    offsets.reserve(entries.size());
+    size_t offset = alignUp(tableSize);
+    for(auto& entry : entries) {
+        offsets.push_back(static_cast<u32>(offset));
+        offset = alignUp(offset + entry.data.size());
+    }
+    if(offset > std::numeric_limits<u32>::max()) {
+        ERROR("[PACK FILE]: " + filePath + " would exceed 4 GiB");
+        return false;
+    }
+
+    BinaryWriter writer;
+    writer.writeU32(PACK_MAGIC);
+    writer.writeU32(PACK_VERSION);
+    writer.writeU32(static_cast<u32>(entries.size()));
+    for(size_t i = 0; i < entries.size(); i++) {
+        writer.writeString(entries[i].path);
+        writer.writeU32(offsets[i]);
+        writer.writeU32(static_cast<u32>(entries[i].data.size()));
+    }
+
+    std::vector<char> padding(PACK_ALIGNMENT, 0);
+    for(size_t i = 0; i < entries.size(); i++) {
+        writer.writeBytes(std::span(padding).first(offsets[i] - writer.data().size()));
+        writer.writeBytes(entries[i].data);
+    }
+
+    if(!FileIO::writeBinaryFile(filePath, writer.data())) {
+        ERROR("[PACK FILE]: failed to write " + filePath);
+        return false;
+    }
+    return true;
+}
+
+bool PackFile::readTableOfContents() {
+    BinaryReader reader(std::span(data_, size_));
+    if(reader.readU32() != PACK_MAGIC || reader.readU32() != PACK_VERSION) {
+        return false;
+    }
+
+    u32 count = reader.readU32();
+    entries_.reserve(count);
+    for(u32 i = 0; i < count && reader.ok(); i++) {
+        auto path = reader.readString();
+        u32 offset = reader.readU32();
+        u32 size = reader.readU32();
+        if(offset > size_ || size > size_ - offset) {
+            return false;
+        }
+        entries_.emplace(std::move(path), std::span(data_ + offset, size));
+    }
+    return reader.ok();
+}
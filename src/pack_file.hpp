@@ -0,0 +1,47 @@
+#pragma once
+
+#include "utils.hpp"
+
+struct PackEntry {
+    std::string path;
+    std::vector<char> data;
+};
+
+/// A single archive of cooked blobs, mapped into memory once and read in place. The file starts
+/// with a table of contents of asset paths, offsets and sizes, the entries follow aligned to
+/// PACK_ALIGNMENT bytes. Spans returned by find stay valid until the pack is closed.
+class PackFile {
+public:
+    PackFile() = default;
+    ~PackFile();
+
+    bool open(const std::string& filePath);
+    void close();
+    bool isOpen() const;
+
+    /// The entry's bytes inside the mapping, empty when the pack does not have it.
+    auto find(const std::string& assetPath) const -> std::span<const std::byte>;
+    bool contains(const std::string& assetPath) const;
+
+    static bool write(const std::string& filePath, const std::vector<PackEntry>& entries);
+
+private:
+    bool readTableOfContents();
+
+private:
+    const std::byte* data_ = nullptr;
+    size_t size_ = 0;
+#ifdef _WIN32
+    void* file_ = nullptr;
+    void* mapping_ = nullptr;
+#else
+    int file_ = -1;
+#endif
+    std::unordered_map<std::string, std::span<const std::byte>> entries_;
+
+private:
+    PackFile(const PackFile&) = delete;
+    PackFile& operator=(const PackFile&) = delete;
+    PackFile(PackFile&&) = delete;
+    PackFile& operator=(PackFile&&) = delete;
+};
@@ -5,6 +5,13 @@ RandomNumberGenerator::RandomNumberGenerator() {
     generator_ = std::mt19937_64(seed());
 }
 
+RandomNumberGenerator::RandomNumberGenerator(u64 seed) : generator_(seed) {
+}
+
+void RandomNumberGenerator::seed(u64 seed) {
+    generator_.seed(seed);
+}
+
 s32 RandomNumberGenerator::getInt(s32 min, s32 max) {
 
     std::uniform_int_distribution<> distrib(min, max);
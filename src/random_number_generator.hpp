@@ -8,9 +8,11 @@ class RandomNumberGenerator {
 
 public:
     RandomNumberGenerator();
+    explicit RandomNumberGenerator(u64 seed);
     ~RandomNumberGenerator() = default;
 
 public:
+    void seed(u64 seed);
     s32 getInt(s32 min, s32 max);
     f32 getFloat(f32 min, f32 max);
     u32 getUnsigned(u32 min, u32 max);
@@ -1,12 +1,17 @@
 #include "renderer.hpp"
 
+#include <SDL3_image/SDL_image.h>
+
+#include <algorithm>
+
 #include "SDL3/SDL_render.h"
-#include "asset_manager.hpp"
+#include "frame_snapshot.hpp"
 #include "log.hpp"
 #include "texture.hpp"
 #include "utils.hpp"
 
-Renderer::Renderer(SDL_Renderer* renderer) {
+Renderer::Renderer(SDL_Renderer* renderer)
+    : frame_(nullptr), drawColor_{0, 0, 0, 0}, batcher_(renderer), terrain_(renderer) {
     renderer_ = renderer;
 }
 
@@ -25,10 +30,32 @@ Renderer Renderer::init(SDL_Window* window) {
     return renderer;
 }
 
+Renderer Renderer::initSoftware(SDL_Surface* surface) {
+    SDL_Renderer* r = SDL_CreateSoftwareRenderer(surface);
+    if(!r) {
+        std::string error = SDL_GetError();
+        FATAL_ERROR("[RENDERER]: failed to init software renderer - " + error);
+    }
+
+    Renderer renderer(r);
+    return renderer;
+}
+
 SDL_Renderer* Renderer::handle() {
     return renderer_;
 }
 
+Camera& Renderer::camera() {
+    return camera_;
+}
+
+auto Renderer::outputSize() -> Vec2 {
+    s32 width = 0;
+    s32 height = 0;
+    SDL_GetRenderOutputSize(renderer_, &width, &height);
+    return {static_cast<f32>(width), static_cast<f32>(height)};
+}
+
 void Renderer::toogleVsync(bool toggle) {
     // vsync is disabled by default
     bool result = false;
@@ -44,145 +71,515 @@ void Renderer::toogleVsync(bool toggle) {
 }
 
 void Renderer::queueRenderTexture(
-    Strata strata, const std::string& textureName, const Rect& sRect, const Rect& dRect) {
-    auto texture = AssetManager::get()->load<Texture>(textureName);
+    Strata strata, TextureHandle texture, const Rect& sRect, const Rect& dRect) {
+    RenderCommand command = {};
+    command.type = RenderCommandType::TEXTURE;
+    command.strata = strata;
+    command.texture = texture;
+    command.src = sRect;
+    command.dst = dRect;
+    command.color = {255, 255, 255, 255};
+    queueCommand(command);
+}
+
+void Renderer::queueRenderTextureRotated(
+    Strata strata, TextureHandle texture, const Rect& sRect, const Rect& dRect, const Vec2& pivot,
+    f32 angle) {
+    RenderCommand command = {};
+    command.type = RenderCommandType::TEXTURE_ROTATED;
+    command.strata = strata;
+    command.texture = texture;
+    command.src = sRect;
+    command.dst = dRect;
+    command.pivot = pivot;
+    command.angle = angle;
+    command.color = {255, 255, 255, 255};
+    queueCommand(command);
+}
+
+void Renderer::queueRenderTextureRotated(
+    Strata strata, TextureHandle texture, Vec2 position, f32 angle, f32 scale, f32 alpha) {
+    RenderCommand command = {};
+    command.type = RenderCommandType::PARTICLE;
+    command.strata = strata;
+    command.texture = texture;
+    command.dst = {position.x, position.y, scale, scale};
+    command.angle = angle;
+    command.color = {255, 255, 255, static_cast<u8>(255 * alpha)};
+    queueCommand(command);
+}
+
+void Renderer::queueRenderRect(Strata strata, const Rect& rect, u8 r, u8 g, u8 b, u8 a) {
+    RenderCommand command = {};
+    command.type = RenderCommandType::RECT;
+    command.strata = strata;
+    command.dst = rect;
+    command.color = {r, g, b, a};
+    queueCommand(command);
+}
+
+void Renderer::queueRenderFilledRect(Strata strata, const Rect& rect, u8 r, u8 g, u8 b, u8 a) {
+    RenderCommand command = {};
+    command.type = RenderCommandType::FILLED_RECT;
+    command.strata = strata;
+    command.dst = rect;
+    command.color = {r, g, b, a};
+    queueCommand(command);
+}
+
+void Renderer::queueRenderLine(Strata strata, const Line& line, u8 r, u8 g, u8 b, u8 a) {
+    RenderCommand command = {};
+    command.type = RenderCommandType::LINE;
+    command.strata = strata;
+    command.dst = {line.p1.x, line.p1.y, line.p2.x, line.p2.y};
+    command.color = {r, g, b, a};
+    queueCommand(command);
+}
+
+void Renderer::queueRenderTerrainChunk(std::shared_ptr<const TilemapData> tilemap, u32 chunk) {
+    assert(frame_);
+    auto& tilemaps = frame_->tilemaps;
+    auto it = std::find(tilemaps.begin(), tilemaps.end(), tilemap);
+    if(it == tilemaps.end()) {
+        it = tilemaps.insert(tilemaps.end(), tilemap);
+    }
 
-    if(!texture) {
-        ERROR_ONCE("[RENDERER]: failed to acquire texture - " + textureName);
+    RenderCommand command = {};
+    command.type = RenderCommandType::TERRAIN_CHUNK;
+    command.strata = Strata::TERRAIN;
+    command.tilemap = static_cast<u32>(it - tilemaps.begin());
+    command.chunk = chunk;
+    command.dst = tilemap->chunkRect(chunk);
+    command.color = {255, 255, 255, 255};
+    queueCommand(command);
+}
+
+void Renderer::queueOverlayBar(
+    const Rect& rect, f32 fill, const SDL_Color& background, const SDL_Color& foreground) {
+    assert(frame_);
+    Rect dst = camera_.worldToScreen(rect);
+    if(!isOnScreen(dst)) {
         return;
     }
+    frame_->overlayBars.push_back(
+        {dst, std::clamp(fill, 0.0f, 1.0f), background, foreground,
+         motion_.offset * camera_.zoom()});
+}
 
-    queueRenderCall(strata, [&, texture, sRect, dRect]() {
-        SDL_FRect srcRect = {sRect.x, sRect.y, sRect.w, sRect.h};
-        SDL_FRect dstRect = {dRect.x, dRect.y, dRect.w, dRect.h};
-        SDL_RenderTexture(renderer_, texture->get(), &srcRect, &dstRect);
-    });
+void Renderer::queueDebugRect(const Rect& rect, u8 r, u8 g, u8 b, u8 a) {
+#ifdef DEBUG
+    assert(frame_);
+    Rect dst = camera_.worldToScreen(rect);
+    if(!isOnScreen(dst)) {
+        return;
+    }
+    frame_->debug.addRect(dst, {r, g, b, a}, motion_.offset * camera_.zoom());
+#endif
 }
 
-void Renderer::queueRenderTextureRotated(
-    Strata strata, const std::string& textureName, const Rect& sRect, const Rect& dRect,
-    const Vec2& pivot, f32 angle) {
-    auto texture = AssetManager::get()->load<Texture>(textureName);
+void Renderer::queueDebugLine(const Line& line, u8 r, u8 g, u8 b, u8 a) {
+#ifdef DEBUG
+    assert(frame_);
+    Vec2 points[2] = {camera_.worldToScreen(line.p1), camera_.worldToScreen(line.p2)};
+    Rect bounds = {
+        std::min(points[0].x, points[1].x), std::min(points[0].y, points[1].y),
+        std::abs(points[1].x - points[0].x), std::abs(points[1].y - points[0].y)};
+    if(!isOnScreen(bounds)) {
+        return;
+    }
+    frame_->debug.addPolyline(points, {r, g, b, a}, motion_.offset * camera_.zoom());
+#endif
+}
 
-    if(!texture) {
-        ERROR_ONCE("[RENDERER]: failed to acquire texture - " + textureName);
+void Renderer::queueDebugCircle(const Circle& circle, u8 r, u8 g, u8 b, u8 a) {
+#ifdef DEBUG
+    assert(frame_);
+    Vec2 center = camera_.worldToScreen(Vec2{circle.x, circle.y});
+    f32 radius = circle.r * camera_.zoom();
+    if(radius <= 0.0f ||
+       !isOnScreen(Rect{center.x - radius, center.y - radius, 2.0f * radius, 2.0f * radius})) {
         return;
     }
-    queueRenderCall(strata, [&, texture, sRect, dRect, angle, pivot]() {
-        SDL_FRect srcRect = {sRect.x, sRect.y, sRect.w, sRect.h};
-        SDL_FRect dstRect = {dRect.x, dRect.y, dRect.w, dRect.h};
-        SDL_FPoint rotationPoint = {pivot.x, pivot.y};
-        // NOTE: We actually have to supply degrees because of SDL;
-        f32 angleInDegrees = math::degrees(angle);
-        SDL_RenderTextureRotated(
-            renderer_, texture->get(), &srcRect, &dstRect, angleInDegrees, &rotationPoint,
-            SDL_FlipMode::SDL_FLIP_NONE);
-    });
+
+    // a segment per pixel of radius, about six pixels of circumference each
+    u32 segments = std::clamp(static_cast<u32>(radius), 12u, 96u);
+    debugPoints_.clear();
+    for(u32 i = 0; i <= segments; i++) {
+        f32 angle = 2.0f * static_cast<f32>(M_PI) * static_cast<f32>(i % segments) / segments;
+        debugPoints_.push_back(
+            {center.x + radius * std::cos(angle), center.y + radius * std::sin(angle)});
+    }
+    frame_->debug.addPolyline(debugPoints_, {r, g, b, a}, motion_.offset * camera_.zoom());
+#endif
 }
 
-void Renderer::queueRenderTextureRotated(
-    Strata strata, const std::string& textureName, Vec2 position, f32 angle, f32 scale, f32 alpha) {
-    auto texture = AssetManager::get()->load<Texture>(textureName);
-    if(!texture) {
-        ERROR_ONCE("[RENDERER]: failed to acquire texture - " + textureName);
+auto Renderer::textureGroup(TextureHandle handle, const Texture& texture) -> u32 {
+    if(handle.id >= textureGroups_.size()) {
+        textureGroups_.resize(handle.id + 1, 0);
+    }
+
+    u32& group = textureGroups_[handle.id];
+    if(group == 0) {
+        auto [it, inserted] =
+            pageGroups_.emplace(texture.get(), static_cast<u32>(pageGroups_.size() + 1));
+        group = it->second;
+    }
+    return group;
+}
+
+void Renderer::queueCommand(RenderCommand command) {
+#ifndef DEBUG
+    if(command.strata == Strata::DEB) {
         return;
     }
+#endif
+    assert(frame_);
+    command.motion = motion_;
+    applyCamera(command);
+    if(!isOnScreen(command)) {
+        return;
+    }
+    frame_->commands.push_back(command);
+}
 
-    queueRenderCall(strata, [&, texture, position, angle, scale, alpha]() {
-        f32 width, height;
-        SDL_GetTextureSize(texture->get(), &width, &height);
-        width *= scale;
-        height *= scale;
-        SDL_FRect dstRect = {position.x - width / 2.0f, position.y - height / 2.0f, width, height};
-        u8 textureAlpha = static_cast<u8>(255 * alpha);
-        SDL_SetTextureAlphaMod(texture->get(), textureAlpha);
-        // NOTE: We actually have to supply degrees because of SDL;
-        f32 angleInDegrees = math::degrees(angle);
-        SDL_RenderTextureRotated(
-            renderer_, texture->get(), nullptr, &dstRect, angleInDegrees, nullptr,
-            SDL_FlipMode::SDL_FLIP_NONE);
-    });
+void Renderer::beginFrame(FrameSnapshot& frame, const Vec2& viewportSize) {
+    // keeps the capacity, steady state frames do not allocate
+    frame.commands.clear();
+    frame.tilemaps.clear();
+    frame.overlayBars.clear();
+    frame.debug.clear();
+    camera_.setViewport({0.0f, 0.0f, viewportSize.x, viewportSize.y});
+    frame_ = &frame;
+    motion_ = {};
 }
 
-void Renderer::queueRenderRect(Strata strata, const Rect& rect, u8 r, u8 g, u8 b, u8 a) {
-    SDL_Color color = {r, g, b, a};
-    queueRenderCall(strata, [&, rect, color]() {
-        SDL_SetRenderDrawColor(renderer_, color.r, color.g, color.b, color.a);
-        SDL_FRect dRect = {rect.x, rect.y, rect.w, rect.h};
-        SDL_RenderRect(renderer_, &dRect);
-    });
+void Renderer::endFrame() {
+    frame_->camera = camera_;
+    frame_ = nullptr;
 }
 
-void Renderer::queueRenderFilledRect(Strata strata, const Rect& rect, u8 r, u8 g, u8 b, u8 a) {
-    SDL_Color color = {r, g, b, a};
-    queueRenderCall(strata, [&, rect, color]() {
-        SDL_SetRenderDrawColor(renderer_, color.r, color.g, color.b, color.a);
-        SDL_FRect dRect = {rect.x, rect.y, rect.w, rect.h};
-        SDL_RenderFillRect(renderer_, &dRect);
-    });
+void Renderer::setMotion(const RenderMotion& motion) {
+    motion_ = motion;
 }
 
-void Renderer::queueRenderLine(Strata strata, const Line& line, u8 r, u8 g, u8 b, u8 a) {
-    SDL_Color color = {r, g, b, a};
-    queueRenderCall(strata, [&, line, color]() {
-        SDL_SetRenderDrawColor(renderer_, color.r, color.g, color.b, color.a);
-        SDL_RenderLine(renderer_, line.p1.x, line.p1.y, line.p2.x, line.p2.y);
-    });
-}
-
-void Renderer::queueRenderCall(Strata strata, std::function<void()> renderCall) {
-    switch(strata) {
-        case Strata::TERRAIN:
-            terrain_.push_back(renderCall);
-            break;
-        case Strata::ENTITY:
-            entities_.push_back(renderCall);
-            break;
-        case Strata::EFFECT:
-            effects_.push_back(renderCall);
-            break;
-        case Strata::UI:
-            ui_.push_back(renderCall);
-            break;
-#ifdef DEBUG
-        case Strata::DEB:
-            debug_.push_back(renderCall);
-            break;
-#endif
-        default:
-            break;
+auto Renderer::motion() const -> RenderMotion {
+    return motion_;
+}
+
+void Renderer::applyCamera(RenderCommand& command) const {
+    command.motion.offset *= camera_.zoom();
+    if(command.type == RenderCommandType::LINE) {
+        Vec2 p1 = camera_.worldToScreen(Vec2{command.dst.x, command.dst.y});
+        Vec2 p2 = camera_.worldToScreen(Vec2{command.dst.w, command.dst.h});
+        command.dst = {p1.x, p1.y, p2.x, p2.y};
+        return;
     }
+    if(command.type == RenderCommandType::PARTICLE) {
+        Vec2 center = camera_.worldToScreen(Vec2{command.dst.x, command.dst.y});
+        f32 scale = command.dst.w * camera_.zoom();
+        command.dst = {center.x, center.y, scale, scale};
+        return;
+    }
+
+    command.dst = camera_.worldToScreen(command.dst);
+    command.pivot *= camera_.zoom();
 }
 
-void Renderer::executeRenderCalls() {
-    renderGroup(terrain_);
-    renderGroup(entities_);
-    renderGroup(effects_);
-    renderGroup(ui_);
-#ifdef DEBUG
-    renderGroup(debug_);
-#endif
+bool Renderer::isOnScreen(const RenderCommand& command) const {
+    // particles are culled when drawn, their size depends on the texture
+    if(command.type == RenderCommandType::PARTICLE) {
+        return true;
+    }
+
+    Rect bounds = command.dst;
+    if(command.type == RenderCommandType::LINE) {
+        bounds.x = std::min(command.dst.x, command.dst.w);
+        bounds.y = std::min(command.dst.y, command.dst.h);
+        bounds.w = std::abs(command.dst.w - command.dst.x);
+        bounds.h = std::abs(command.dst.h - command.dst.y);
+    } else if(command.type == RenderCommandType::TEXTURE_ROTATED) {
+        // the quad turns around its pivot and never leaves its diagonal
+        f32 reach = command.dst.w + command.dst.h;
+        bounds = {
+            command.dst.x + command.pivot.x - reach, command.dst.y + command.pivot.y - reach,
+            2.0f * reach, 2.0f * reach};
+    }
+    return isOnScreen(bounds);
+}
+
+bool Renderer::isOnScreen(const Rect& bounds) const {
+    return overlaps(bounds, camera_.viewport());
+}
+
+bool Renderer::overlaps(const Rect& bounds, const Rect& viewport) {
+    return bounds.x <= viewport.x + viewport.w && bounds.x + bounds.w >= viewport.x &&
+           bounds.y <= viewport.y + viewport.h && bounds.y + bounds.h >= viewport.y;
+}
+
+void Renderer::rewindCommand(RenderCommand& command, f32 rewind) {
+    Vec2 offset = command.motion.offset * rewind;
+    command.dst.x -= offset.x;
+    command.dst.y -= offset.y;
+    if(command.type == RenderCommandType::LINE) {
+        command.dst.w -= offset.x;
+        command.dst.h -= offset.y;
+    }
+    command.angle -= command.motion.spin * rewind;
+}
+
+auto Renderer::sortKey(Strata strata, u32 group, u32 sequence) -> u64 {
+    // 8 bits strata, 24 bits texture page, 32 bits submission order
+    return (static_cast<u64>(strata) << 56) | (static_cast<u64>(group & 0xFFFFFF) << 32) |
+           static_cast<u64>(sequence);
+}
+
+void Renderer::setDrawColor(const SDL_Color& color) {
+    if(color.r == drawColor_.r && color.g == drawColor_.g && color.b == drawColor_.b &&
+       color.a == drawColor_.a) {
+        return;
+    }
+    drawColor_ = color;
+    SDL_SetRenderDrawColor(renderer_, color.r, color.g, color.b, color.a);
+}
+
+void Renderer::executeRenderCalls(const FrameSnapshot& frame, f32 alpha) {
+    const auto& commands = frame.commands;
+    // the camera the frame was recorded with, the simulation moves camera_ meanwhile
+    Rect viewport = frame.camera.viewport();
+    f32 rewind = 1.0f - std::clamp(alpha, 0.0f, 1.0f);
+
+    // every command's texture is resolved once, the registry takes its lock per call
+    order_.clear();
+    textures_.clear();
+    for(u32 i = 0; i < commands.size(); i++) {
+        u32 group = 0;
+        Texture* texture = nullptr;
+        if(commands[i].texture.valid()) {
+            texture = TextureRegistry::get().resolve(commands[i].texture);
+        }
+        if(texture) {
+            group = textureGroup(commands[i].texture, *texture);
+        }
+        textures_.push_back(texture);
+        order_.emplace_back(sortKey(commands[i].strata, group, i), i);
+    }
+    std::sort(order_.begin(), order_.end());
+
+    prepareTerrain(frame);
+
+    // Sprites and filled rects go through the batcher, consecutive commands sharing a texture end
+    // up in a single geometry call. Outlines and lines cannot be expressed as triangles cheaply,
+    // they flush the pending batch to keep the draw order.
+    for(auto& [key, index] : order_) {
+        RenderCommand command = commands[index];
+        rewindCommand(command, rewind);
+        switch(command.type) {
+            case RenderCommandType::TEXTURE:
+            case RenderCommandType::TEXTURE_ROTATED:
+            case RenderCommandType::PARTICLE: {
+                // the registry returns nothing while a texture loads and when it failed to
+                auto texture = textures_[index];
+                if(!texture) {
+                    break;
+                }
+                Rect region = texture->region();
+
+                Rect src = command.src;
+                Rect dst = command.dst;
+                Vec2 pivot = command.pivot;
+                if(command.type == RenderCommandType::PARTICLE) {
+                    // the whole texture, scaled around its center
+                    f32 width = region.w * command.dst.w;
+                    f32 height = region.h * command.dst.h;
+                    src = {0.0f, 0.0f, region.w, region.h};
+                    dst = {
+                        command.dst.x - width / 2.0f, command.dst.y - height / 2.0f, width,
+                        height};
+                    pivot = {width / 2.0f, height / 2.0f};
+
+                    // turning around its center, the quad stays within half its diagonal
+                    f32 reach = (width + height) / 2.0f;
+                    Rect bounds = {
+                        command.dst.x - reach, command.dst.y - reach, 2.0f * reach,
+                        2.0f * reach};
+                    if(!overlaps(bounds, viewport)) {
+                        break;
+                    }
+                }
+
+                // Like SDL_RenderTexture, clip the source to the sprite and stretch whatever is
+                // left over the destination. With atlas pages anything outside would sample
+                // neighbouring sprites.
+                f32 right = std::min(src.x + src.w, region.w);
+                f32 bottom = std::min(src.y + src.h, region.h);
+                src.x = std::max(src.x, 0.0f);
+                src.y = std::max(src.y, 0.0f);
+                src.w = right - src.x;
+                src.h = bottom - src.y;
+                if(src.w <= 0.0f || src.h <= 0.0f) {
+                    break;
+                }
+                src.x += region.x;
+                src.y += region.y;
+
+                SDL_FColor color = {1.0f, 1.0f, 1.0f, command.color.a / 255.0f};
+                f32 angle = command.type == RenderCommandType::TEXTURE ? 0.0f : command.angle;
+                batcher_.addQuad(
+                    texture->get(), texture->pageSize(), src, dst, pivot, angle, color);
+                break;
+            }
+            case RenderCommandType::TERRAIN_CHUNK: {
+                const TilemapData& tilemap = *frame.tilemaps[command.tilemap];
+                auto chunk = terrain_.chunk(tilemap, command.chunk);
+                if(!chunk) {
+                    break;
+                }
+
+                // chunk textures are one texel per world unit
+                Rect bounds = tilemap.chunkRect(command.chunk);
+                Rect src = {0.0f, 0.0f, bounds.w, bounds.h};
+                SDL_FColor color = {1.0f, 1.0f, 1.0f, 1.0f};
+                batcher_.addQuad(
+                    chunk, {bounds.w, bounds.h}, src, command.dst, {0.0f, 0.0f}, 0.0f, color);
+                break;
+            }
+            case RenderCommandType::FILLED_RECT: {
+                SDL_FColor color = {
+                    command.color.r / 255.0f, command.color.g / 255.0f, command.color.b / 255.0f,
+                    command.color.a / 255.0f};
+                batcher_.addFilledRect(command.dst, color);
+                break;
+            }
+            case RenderCommandType::RECT: {
+                batcher_.flush();
+                SDL_FRect dRect = {command.dst.x, command.dst.y, command.dst.w, command.dst.h};
+                setDrawColor(command.color);
+                SDL_RenderRect(renderer_, &dRect);
+                break;
+            }
+            case RenderCommandType::LINE: {
+                batcher_.flush();
+                setDrawColor(command.color);
+                SDL_RenderLine(
+                    renderer_, command.dst.x, command.dst.y, command.dst.w, command.dst.h);
+                break;
+            }
+            default:
+                break;
+        }
+    }
+    batcher_.flush();
+
+    drawOverlayBars(frame.overlayBars, rewind);
+    drawDebug(frame.debug, rewind);
+}
+
+void Renderer::drawOverlayBars(const std::vector<OverlayBar>& bars, f32 rewind) {
+    auto toFColor = [](const SDL_Color& color) -> SDL_FColor {
+        return {color.r / 255.0f, color.g / 255.0f, color.b / 255.0f, color.a / 255.0f};
+    };
+
+    // untextured quads never break the batch, all bars end up in one geometry call
+    for(auto& bar : bars) {
+        Rect rect = bar.rect;
+        rect.x -= bar.offset.x * rewind;
+        rect.y -= bar.offset.y * rewind;
+        batcher_.addFilledRect(rect, toFColor(bar.background));
+        if(bar.fill > 0.0f) {
+            rect.w *= bar.fill;
+            batcher_.addFilledRect(rect, toFColor(bar.foreground));
+        }
+    }
+    batcher_.flush();
+}
+
+void Renderer::drawDebug(const DebugDrawBuffer& debug, f32 rewind) {
+    for(auto& batch : debug.batches()) {
+        if(batch.rects.empty() && batch.polylines.empty()) {
+            continue;
+        }
+        setDrawColor(batch.color);
+
+        if(!batch.rects.empty()) {
+            debugRects_.assign(batch.rects.begin(), batch.rects.end());
+            for(u32 i = 0; i < debugRects_.size(); i++) {
+                debugRects_[i].x -= batch.rectOffsets[i].x * rewind;
+                debugRects_[i].y -= batch.rectOffsets[i].y * rewind;
+            }
+            SDL_RenderRects(renderer_, debugRects_.data(), static_cast<s32>(debugRects_.size()));
+        }
+
+        if(batch.polylines.empty()) {
+            continue;
+        }
+        // strips are moved in a scratch copy, one SDL_RenderLines call each
+        debugStrip_.assign(batch.points.begin(), batch.points.end());
+        for(auto& polyline : batch.polylines) {
+            for(u32 i = polyline.first; i < polyline.first + polyline.count; i++) {
+                debugStrip_[i].x -= polyline.offset.x * rewind;
+                debugStrip_[i].y -= polyline.offset.y * rewind;
+            }
+            SDL_RenderLines(
+                renderer_, debugStrip_.data() + polyline.first, static_cast<s32>(polyline.count));
+        }
+    }
 }
 
 void Renderer::present() {
     SDL_RenderPresent(renderer_);
 }
 
-void Renderer::renderGroup(const std::vector<std::function<void()>>& group) {
-    for(auto& fn : group) {
-        fn();
+void Renderer::renderLoadingScreen(f32 progress) {
+    Vec2 size = outputSize();
+    Rect bar = {size.x * 0.25f, size.y * 0.5f - 8.0f, size.x * 0.5f, 16.0f};
+
+    clear();
+    batcher_.addFilledRect(bar, {0.0f, 0.0f, 0.0f, 1.0f});
+    bar.w *= std::clamp(progress, 0.0f, 1.0f);
+    batcher_.addFilledRect(bar, {0.8f, 0.8f, 0.8f, 1.0f});
+    batcher_.flush();
+    present();
+}
+
+bool Renderer::capture(const std::string& filePath) {
+    SDL_Surface* surface = SDL_RenderReadPixels(renderer_, nullptr);
+    if(!surface) {
+        ERROR("[RENDERER]: failed to read pixels - " + std::string(SDL_GetError()));
+        return false;
+    }
+
+    bool saved = IMG_SavePNG(surface, filePath.c_str());
+    SDL_DestroySurface(surface);
+    if(!saved) {
+        ERROR("[RENDERER]: failed to save " + filePath + " - " + std::string(SDL_GetError()));
     }
+    return saved;
 }
 
-void Renderer::clear() {
+void Renderer::invalidateRenderTargets() {
     terrain_.clear();
-    entities_.clear();
-    effects_.clear();
-    ui_.clear();
-#ifdef DEBUG
-    debug_.clear();
-#endif
+}
 
-    SDL_SetRenderDrawColor(renderer_, 0, 50, 0, 255);
+void Renderer::prepareTerrain(const FrameSnapshot& frame) {
+    terrain_.releaseUnused();
+
+    // chunk textures are rendered before the pass starts, building one switches the render target
+    bool built = false;
+    for(auto& command : frame.commands) {
+        if(command.type == RenderCommandType::TERRAIN_CHUNK) {
+            terrain_.prepare(frame.tilemaps[command.tilemap], command.chunk, batcher_);
+            built = true;
+        }
+    }
+
+    if(built) {
+        // building overwrote the draw color behind the cache's back
+        SDL_SetRenderDrawColor(renderer_, drawColor_.r, drawColor_.g, drawColor_.b, drawColor_.a);
+    }
+}
+
+void Renderer::clear() {
+    drawColor_ = {0, 50, 0, 255};
+    SDL_SetRenderDrawColor(renderer_, drawColor_.r, drawColor_.g, drawColor_.b, drawColor_.a);
     SDL_RenderClear(renderer_);
 }
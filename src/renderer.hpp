@@ -1,52 +1,168 @@
 #pragma once
 #include <SDL3/SDL.h>
 
-#include <functional>
-
+#include "camera.hpp"
+#include "debug_draw.hpp"
 #include "math.hpp"
+#include "sprite_batcher.hpp"
+#include "terrain_cache.hpp"
+#include "texture_registry.hpp"
 
 enum class Strata { TERRAIN = 1, ENTITY = 2, EFFECT = 3, UI = 4, DEB = 5 };
 
+enum class RenderCommandType : u8 {
+    TEXTURE,
+    TEXTURE_ROTATED,
+    PARTICLE,
+    TERRAIN_CHUNK,
+    RECT,
+    FILLED_RECT,
+    LINE
+};
+
+/// Movement covered during the last simulation step. Commands are drawn this far back along it,
+/// scaled by 1 - alpha, so motion stays smooth between steps.
+struct RenderMotion {
+    Vec2 offset{0.0f, 0.0f};
+    // radians
+    f32 spin{0.0f};
+};
+
+/// A single queued draw in screen space. Plain data only, so a frame of commands can be handed to
+/// the render thread and reused between frames without touching the heap.
+struct RenderCommand {
+    RenderCommandType type;
+    Strata strata;
+    // invalid for untextured commands
+    TextureHandle texture;
+    // TERRAIN_CHUNK only, index into FrameSnapshot::tilemaps and the chunk within that tilemap
+    u32 tilemap;
+    u32 chunk;
+    Rect src;
+    // LINE stores its end points as (x, y) and (w, h), PARTICLE its center as (x, y) and its scale
+    // as w, the texture size is only known to the render thread
+    Rect dst;
+    Vec2 pivot;
+    // radians
+    f32 angle;
+    // draw color for shapes, vertex color (alpha) for textures
+    SDL_Color color;
+    RenderMotion motion;
+};
+
+/// A bar over an entity, filled from the left. Bars are gathered apart from the commands and drawn
+/// together with a single geometry call on top of the scene.
+struct OverlayBar {
+    Rect rect;
+    // 0 to 1
+    f32 fill;
+    SDL_Color background;
+    SDL_Color foreground;
+    // see RenderMotion
+    Vec2 offset;
+};
+
+struct FrameSnapshot;
+struct TilemapData;
+
+/// Split between two threads. The simulation records queue calls into a FrameSnapshot between
+/// beginFrame and endFrame, the render thread owns the SDL renderer and draws published frames.
 class Renderer {
 public:
     Renderer(SDL_Renderer* renderer);
     void destroy();
     static Renderer init(SDL_Window* window);
+    /// Draws into the surface on the CPU, needs neither a display nor a GPU.
+    static Renderer initSoftware(SDL_Surface* surface);
 
 public:
     SDL_Renderer* handle();
+    /// Applied to every queued command, all queue calls take world coordinates. Simulation thread.
+    Camera& camera();
+    /// Size of the render output in pixels. Render thread.
+    auto outputSize() -> Vec2;
     void toogleVsync(bool toggle);
     void queueRenderTexture(
-        Strata strata, const std::string& textureName, const Rect& sRect, const Rect& dRect);
+        Strata strata, TextureHandle texture, const Rect& sRect, const Rect& dRect);
     void queueRenderTextureRotated(
-        Strata strata, const std::string& textureName, const Rect& sRect, const Rect& dRect,
+        Strata strata, TextureHandle texture, const Rect& sRect, const Rect& dRect,
         const Vec2& pivot, f32 angle);
     void queueRenderTextureRotated(
-        Strata strata, const std::string& textureName, Vec2 position, f32 angle, f32 scale,
-        f32 alpha);
+        Strata strata, TextureHandle texture, Vec2 position, f32 angle, f32 scale, f32 alpha);
 
     void queueRenderRect(Strata strata, const Rect& rect, u8 r = 0, u8 g = 0, u8 b = 0, u8 a = 255);
     void queueRenderFilledRect(
         Strata strata, const Rect& rect, u8 r = 0, u8 g = 0, u8 b = 0, u8 a = 255);
 
     void queueRenderLine(Strata strata, const Line& line, u8 r = 0, u8 g = 0, u8 b = 0, u8 a = 255);
-    void executeRenderCalls();
+    void queueRenderTerrainChunk(std::shared_ptr<const TilemapData> tilemap, u32 chunk);
+    void queueOverlayBar(
+        const Rect& rect, f32 fill, const SDL_Color& background, const SDL_Color& foreground);
+
+    /// Debug overlay shapes, batched by color and drawn above everything else. Dropped unless
+    /// built with DEBUG.
+    void queueDebugRect(const Rect& rect, u8 r = 0, u8 g = 0, u8 b = 0, u8 a = 255);
+    void queueDebugLine(const Line& line, u8 r = 0, u8 g = 0, u8 b = 0, u8 a = 255);
+    void queueDebugCircle(const Circle& circle, u8 r = 0, u8 g = 0, u8 b = 0, u8 a = 255);
+
+    /// simulation thread
+    void beginFrame(FrameSnapshot& frame, const Vec2& viewportSize);
+    void endFrame();
+    /// Attached to every command queued until it changes, in world units.
+    void setMotion(const RenderMotion& motion);
+    auto motion() const -> RenderMotion;
+
+    /// render thread, alpha blends each command between its previous and current state
+    void executeRenderCalls(const FrameSnapshot& frame, f32 alpha);
     void present();
     void clear();
+    /// Draws a progress bar over an empty screen and presents it right away, for loading outside
+    /// the frame loop. Render thread.
+    void renderLoadingScreen(f32 progress);
+    /// Saves the current render output as a PNG. Render thread.
+    bool capture(const std::string& filePath);
+    /// Render targets are gone after a device or target reset. Render thread.
+    void invalidateRenderTargets();
 
 private:
-    void renderGroup(const std::vector<std::function<void()>>& group);
-    void queueRenderCall(Strata strata, std::function<void()> renderCall);
+    auto textureGroup(TextureHandle handle, const Texture& texture) -> u32;
+    void queueCommand(RenderCommand command);
+    void applyCamera(RenderCommand& command) const;
+    bool isOnScreen(const RenderCommand& command) const;
+    bool isOnScreen(const Rect& bounds) const;
+    static bool overlaps(const Rect& bounds, const Rect& viewport);
+    void setDrawColor(const SDL_Color& color);
+    void prepareTerrain(const FrameSnapshot& frame);
+    void drawOverlayBars(const std::vector<OverlayBar>& bars, f32 rewind);
+    void drawDebug(const DebugDrawBuffer& debug, f32 rewind);
+
+    static void rewindCommand(RenderCommand& command, f32 rewind);
+    static auto sortKey(Strata strata, u32 group, u32 sequence) -> u64;
 
 private:
     SDL_Renderer* renderer_;
 
 private:
-    std::vector<std::function<void()>> terrain_;
-    std::vector<std::function<void()>> entities_;
-    std::vector<std::function<void()>> effects_;
-    std::vector<std::function<void()>> ui_;
-#ifdef DEBUG
-    std::vector<std::function<void()>> debug_;
-#endif
+    // simulation side
+    Camera camera_;
+    FrameSnapshot* frame_;
+    RenderMotion motion_;
+    std::vector<Vec2> debugPoints_;
+
+private:
+    // render side
+    std::vector<std::pair<u64, u32>> order_;
+    // the resolved texture of every command, by command index
+    std::vector<Texture*> textures_;
+
+    // sprites sharing an atlas page share a sort group so they end up in the same batch, indexed
+    // by texture handle
+    std::vector<u32> textureGroups_;
+    std::unordered_map<SDL_Texture*, u32> pageGroups_;
+    SDL_Color drawColor_;
+    SpriteBatcher batcher_;
+    TerrainCache terrain_;
+    // debug shapes moved back along their motion
+    std::vector<SDL_FRect> debugRects_;
+    std::vector<SDL_FPoint> debugStrip_;
 };
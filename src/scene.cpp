@@ -1,10 +1,67 @@
 #include "scene.hpp"
 
+#include "world_streamer.hpp"
+
 auto Scene::create(const std::string& name, bool lazyAttach) -> std::shared_ptr<Scene> {
     auto scene = std::make_shared<Scene>(name, lazyAttach);
     return scene;
 }
 
+Scene::~Scene() = default;
+
 auto Scene::entityCreator() const -> const EntityCreator& {
     return entityCreator_;
 }
+
+void Scene::queueEntity(QueuedEntity entity) {
+    queuedEntities_.push_back(std::move(entity));
+}
+
+bool Scene::instantiate(std::chrono::microseconds budget) {
+    auto start = std::chrono::steady_clock::now();
+    if(!attached_) {
+        // no children yet, entities added from now on are attached as they are added
+        executeAttached();
+        attached_ = true;
+    }
+
+    while(nextEntity_ < queuedEntities_.size()) {
+        auto& queued = queuedEntities_[nextEntity_++];
+        auto entity = entityCreator_.createEntity(queued.name, queued.source);
+        if(entity) {
+            entity->setTransform(queued.transform);
+            addChild(entity);
+        } else {
+            ERROR("[SCENE]: failed to create entity " + queued.name + " in " + name());
+        }
+        // the prefab stays cached in the asset manager as long as anyone needs it
+        queued.source = nullptr;
+
+        if(budget != std::chrono::microseconds::zero() &&
+           std::chrono::steady_clock::now() - start >= budget) {
+            break;
+        }
+    }
+    return instantiated();
+}
+
+bool Scene::instantiated() const {
+    return attached_ && nextEntity_ == queuedEntities_.size();
+}
+
+auto Scene::instantiationProgress() const -> f32 {
+    if(queuedEntities_.empty()) {
+        return attached_ ? 1.0f : 0.0f;
+    }
+    return static_cast<f32>(nextEntity_) / static_cast<f32>(queuedEntities_.size());
+}
+
+void Scene::enableStreaming(f32 chunkSize, const std::string& chunkDirectory) {
+    streamer_ = std::make_unique<WorldStreamer>(chunkSize, chunkDirectory);
+}
+
+void Scene::stream(std::chrono::microseconds budget) {
+    if(streamer_) {
+        streamer_->update(*this, budget);
+    }
+}
@@ -1,15 +1,48 @@
 #pragma once
 
 #include "entity.hpp"
+#include "asset_id.hpp"
 #include "entity_creator.hpp"
 #include "i_asset.hpp"
 
+/// An entity of the scene file waiting to be created, its prefab is already loaded.
+struct QueuedEntity {
+    std::string name;
+    AssetId prefab;
+    std::shared_ptr<EntityData> source;
+    Transform transform;
+};
+
+class WorldStreamer;
+
+/// Loading a scene only reads its file, the entities are created and attached by instantiate, a
+/// few at a time, so building a large level never blocks a whole frame.
 class Scene : public Entity, public IAsset {
 public:
     static auto create(const std::string& name, bool lazyAttach) -> std::shared_ptr<Scene>;
     auto entityCreator() const -> const EntityCreator&;
     using Entity::Entity;
+    ~Scene();
+
+    void queueEntity(QueuedEntity entity);
+    /// Attaches the scene's own components on the first call, then creates and attaches queued
+    /// entities in file order until the budget is spent, a zero budget does all of them. Each call
+    /// resumes where the last one stopped. Returns true once nothing is queued any more.
+    /// Simulation thread, outside of updates.
+    bool instantiate(std::chrono::microseconds budget);
+    bool instantiated() const;
+    /// Fraction of the queued entities created so far.
+    auto instantiationProgress() const -> f32;
+
+    /// Streams the rest of the world in chunks around the player, see WorldStreamer.
+    void enableStreaming(f32 chunkSize, const std::string& chunkDirectory);
+    /// Does nothing for scenes loaded as a whole. Simulation thread, between ticks.
+    void stream(std::chrono::microseconds budget);
 
 private:
     EntityCreator entityCreator_;
+    std::unique_ptr<WorldStreamer> streamer_;
+    std::vector<QueuedEntity> queuedEntities_;
+    size_t nextEntity_{0};
+    bool attached_{false};
 };
@@ -0,0 +1,95 @@
+#include "spatial_grid.hpp"
+
+#include <algorithm>
+
+SpatialGrid::SpatialGrid(f32 cellSize) : cellSize_(cellSize) {
+}
+
+void SpatialGrid::update(Item item, const Rect& bounds) {
+    CellRange range = cellRange(bounds);
+
+    auto it = items_.find(item);
+    if(it == items_.end()) {
+        items_.emplace(item, range);
+        insertInto(item, range);
+        return;
+    }
+
+    if(it->second == range) {
+        return;
+    }
+
+    removeFrom(item, it->second);
+    insertInto(item, range);
+    it->second = range;
+}
+
+void SpatialGrid::remove(Item item) {
+    auto it = items_.find(item);
+    if(it == items_.end()) {
+        return;
+    }
+
+    removeFrom(item, it->second);
+    items_.erase(it);
+}
+
+void SpatialGrid::query(const Rect& area, std::vector<Item>& result) const {
+    size_t first = result.size();
+    CellRange range = cellRange(area);
+    for(s32 y = range.minY; y <= range.maxY; y++) {
+        for(s32 x = range.minX; x <= range.maxX; x++) {
+            auto cell = cells_.find(cellKey(x, y));
+            if(cell != cells_.end()) {
+                result.insert(result.end(), cell->second.begin(), cell->second.end());
+            }
+        }
+    }
+
+    // items larger than a cell show up once per overlapped cell
+    std::sort(result.begin() + first, result.end());
+    result.erase(std::unique(result.begin() + first, result.end()), result.end());
+}
+
+auto SpatialGrid::size() const -> u32 {
+    return static_cast<u32>(items_.size());
+}
+
+auto SpatialGrid::cellRange(const Rect& bounds) const -> CellRange {
+    return {
+        static_cast<s32>(std::floor(bounds.x / cellSize_)),
+        static_cast<s32>(std::floor(bounds.y / cellSize_)),
+        static_cast<s32>(std::floor((bounds.x + bounds.w) / cellSize_)),
+        static_cast<s32>(std::floor((bounds.y + bounds.h) / cellSize_))};
+}
+
+void SpatialGrid::insertInto(Item item, const CellRange& range) {
+    for(s32 y = range.minY; y <= range.maxY; y++) {
+        for(s32 x = range.minX; x <= range.maxX; x++) {
+            cells_[cellKey(x, y)].push_back(item);
+        }
+    }
+}
+
+void SpatialGrid::removeFrom(Item item, const CellRange& range) {
+    for(s32 y = range.minY; y <= range.maxY; y++) {
+        for(s32 x = range.minX; x <= range.maxX; x++) {
+            auto cell = cells_.find(cellKey(x, y));
+            if(cell == cells_.end()) {
+                continue;
+            }
+
+            auto& bucket = cell->second;
+            auto found = std::find(bucket.begin(), bucket.end(), item);
+            // empty buckets are kept, moving items would otherwise reallocate them constantly
+            if(found != bucket.end()) {
+                *found = bucket.back();
+                bucket.pop_back();
+            }
+        }
+    }
+}
+
+auto SpatialGrid::cellKey(s32 x, s32 y) -> u64 {
+    return (static_cast<u64>(static_cast<u32>(x)) << 32) | static_cast<u64>(static_cast<u32>(y));
+}
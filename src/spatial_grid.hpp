@@ -0,0 +1,39 @@
+#pragma once
+
+#include "math.hpp"
+
+class GeometryComponent;
+
+/// Uniform grid over world space. Items are bucketed by the cells their bounds overlap, so a
+/// region query only looks at the items near that region instead of every item in the world.
+class SpatialGrid {
+public:
+    using Item = GeometryComponent*;
+
+    explicit SpatialGrid(f32 cellSize);
+
+    /// Inserts the item or moves it to its new bounds. Cheap when the item stays in its cells.
+    void update(Item item, const Rect& bounds);
+    void remove(Item item);
+    /// Appends every item whose cells overlap the area to result, each item once.
+    void query(const Rect& area, std::vector<Item>& result) const;
+    auto size() const -> u32;
+
+private:
+    struct CellRange {
+        s32 minX, minY, maxX, maxY;
+
+        bool operator==(const CellRange&) const = default;
+    };
+
+    auto cellRange(const Rect& bounds) const -> CellRange;
+    void insertInto(Item item, const CellRange& range);
+    void removeFrom(Item item, const CellRange& range);
+
+    static auto cellKey(s32 x, s32 y) -> u64;
+
+private:
+    f32 cellSize_;
+    std::unordered_map<u64, std::vector<Item>> cells_;
+    std::unordered_map<Item, CellRange> items_;
+};
@@ -0,0 +1,78 @@
+#include "sprite_batcher.hpp"
+
+SpriteBatcher::SpriteBatcher(SDL_Renderer* renderer) : renderer_(renderer), texture_(nullptr) {
+}
+
+void SpriteBatcher::addQuad(
+    SDL_Texture* texture, const Vec2& textureSize, const Rect& src, const Rect& dst,
+    const Vec2& pivot, f32 angle, const SDL_FColor& color) {
+    bindTexture(texture);
+
+    // corners relative to the pivot, rotated on the CPU and moved back into place
+    f32 c = cosf(angle);
+    f32 s = sinf(angle);
+    Vec2 local[4] = {
+        {-pivot.x, -pivot.y},
+        {dst.w - pivot.x, -pivot.y},
+        {dst.w - pivot.x, dst.h - pivot.y},
+        {-pivot.x, dst.h - pivot.y}};
+
+    SDL_FPoint corners[4];
+    for(u32 i = 0; i < 4; i++) {
+        corners[i].x = dst.x + pivot.x + local[i].x * c - local[i].y * s;
+        corners[i].y = dst.y + pivot.y + local[i].x * s + local[i].y * c;
+    }
+
+    f32 u0 = src.x / textureSize.x;
+    f32 v0 = src.y / textureSize.y;
+    f32 u1 = (src.x + src.w) / textureSize.x;
+    f32 v1 = (src.y + src.h) / textureSize.y;
+    SDL_FPoint uvs[4] = {{u0, v0}, {u1, v0}, {u1, v1}, {u0, v1}};
+
+    pushQuad(corners, uvs, color);
+}
+
+void SpriteBatcher::addFilledRect(const Rect& rect, const SDL_FColor& color) {
+    bindTexture(nullptr);
+
+    SDL_FPoint corners[4] = {
+        {rect.x, rect.y},
+        {rect.x + rect.w, rect.y},
+        {rect.x + rect.w, rect.y + rect.h},
+        {rect.x, rect.y + rect.h}};
+    SDL_FPoint uvs[4] = {};
+
+    pushQuad(corners, uvs, color);
+}
+
+void SpriteBatcher::flush() {
+    if(indices_.empty()) {
+        return;
+    }
+
+    SDL_RenderGeometry(
+        renderer_, texture_, vertices_.data(), static_cast<s32>(vertices_.size()), indices_.data(),
+        static_cast<s32>(indices_.size()));
+
+    // keep the capacity for the next batch
+    vertices_.clear();
+    indices_.clear();
+}
+
+void SpriteBatcher::bindTexture(SDL_Texture* texture) {
+    if(texture != texture_) {
+        flush();
+        texture_ = texture;
+    }
+}
+
+void SpriteBatcher::pushQuad(
+    const SDL_FPoint* corners, const SDL_FPoint* uvs, const SDL_FColor& color) {
+    s32 first = static_cast<s32>(vertices_.size());
+    for(u32 i = 0; i < 4; i++) {
+        vertices_.push_back({corners[i], color, uvs[i]});
+    }
+
+    indices_.insert(
+        indices_.end(), {first, first + 1, first + 2, first + 2, first + 3, first});
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+
+#include "math.hpp"
+
+/// Collects quads into vertex/index arrays and submits every run of quads sharing a texture with a
+/// single SDL_RenderGeometry call. Untextured quads (filled rects) batch the same way with a null
+/// texture. Adding a quad with a different texture flushes the pending batch first.
+class SpriteBatcher {
+public:
+    explicit SpriteBatcher(SDL_Renderer* renderer);
+
+    /// src is in texels, pivot is relative to the top left corner of dst and the angle is in
+    /// radians, clockwise, matching SDL_RenderTextureRotated.
+    void addQuad(
+        SDL_Texture* texture, const Vec2& textureSize, const Rect& src, const Rect& dst,
+        const Vec2& pivot, f32 angle, const SDL_FColor& color);
+    void addFilledRect(const Rect& rect, const SDL_FColor& color);
+    void flush();
+
+private:
+    void bindTexture(SDL_Texture* texture);
+    void pushQuad(const SDL_FPoint* corners, const SDL_FPoint* uvs, const SDL_FColor& color);
+
+private:
+    SDL_Renderer* renderer_;
+    SDL_Texture* texture_;
+    std::vector<SDL_Vertex> vertices_;
+    std::vector<s32> indices_;
+};
@@ -0,0 +1,110 @@
+#include "terrain_cache.hpp"
+
+#include "components/tilemap.hpp"
+#include "log.hpp"
+#include "texture.hpp"
+
+TerrainCache::TerrainCache(SDL_Renderer* renderer) : renderer_(renderer) {
+}
+
+void TerrainCache::prepare(
+    const std::shared_ptr<const TilemapData>& tilemap, u32 chunk, SpriteBatcher& batcher) {
+    auto& entry = chunks_[tilemap->id];
+    if(entry.textures.empty()) {
+        entry.tilemap = tilemap;
+        entry.textures.resize(tilemap->chunkColumns * tilemap->chunkRows, nullptr);
+    }
+
+    if(!entry.textures[chunk]) {
+        entry.textures[chunk] = build(*tilemap, chunk, batcher);
+    }
+}
+
+auto TerrainCache::chunk(const TilemapData& tilemap, u32 chunk) const -> SDL_Texture* {
+    auto it = chunks_.find(tilemap.id);
+    if(it == chunks_.end()) {
+        return nullptr;
+    }
+    return it->second.textures[chunk];
+}
+
+void TerrainCache::clear() {
+    for(auto& [id, entry] : chunks_) {
+        destroy(entry);
+    }
+    chunks_.clear();
+}
+
+void TerrainCache::releaseUnused() {
+    for(auto it = chunks_.begin(); it != chunks_.end();) {
+        if(it->second.tilemap.expired()) {
+            destroy(it->second);
+            it = chunks_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void TerrainCache::destroy(Entry& entry) {
+    for(auto texture : entry.textures) {
+        if(texture) {
+            SDL_DestroyTexture(texture);
+        }
+    }
+    entry.textures.clear();
+}
+
+auto TerrainCache::build(const TilemapData& tilemap, u32 chunk, SpriteBatcher& batcher)
+    -> SDL_Texture* {
+    auto tileset = TextureRegistry::get().resolve(tilemap.tileset);
+    if(!tileset) {
+        return nullptr;
+    }
+
+    Rect bounds = tilemap.chunkRect(chunk);
+    SDL_Texture* texture = SDL_CreateTexture(
+        renderer_, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_TARGET, static_cast<s32>(bounds.w),
+        static_cast<s32>(bounds.h));
+    if(!texture) {
+        std::string error = SDL_GetError();
+        ERROR_ONCE("[TERRAIN CACHE]: failed to create chunk texture - " + error);
+        return nullptr;
+    }
+    SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+
+    SDL_Texture* previousTarget = SDL_GetRenderTarget(renderer_);
+    SDL_SetRenderTarget(renderer_, texture);
+    SDL_SetRenderDrawColor(renderer_, 0, 0, 0, 0);
+    SDL_RenderClear(renderer_);
+
+    Rect region = tileset->region();
+    f32 tileSize = static_cast<f32>(tilemap.tileSize);
+    u32 tilesetColumns = static_cast<u32>(region.w) / tilemap.tileSize;
+    u32 tilesetTiles = tilesetColumns * (static_cast<u32>(region.h) / tilemap.tileSize);
+    u32 firstColumn = static_cast<u32>(bounds.x / tileSize);
+    u32 firstRow = static_cast<u32>(bounds.y / tileSize);
+    u32 columns = static_cast<u32>(bounds.w / tileSize);
+    u32 rows = static_cast<u32>(bounds.h / tileSize);
+    SDL_FColor white = {1.0f, 1.0f, 1.0f, 1.0f};
+
+    for(u32 row = 0; row < rows; row++) {
+        for(u32 column = 0; column < columns; column++) {
+            s32 tile = tilemap.tile(firstColumn + column, firstRow + row);
+            if(tile < 0 || static_cast<u32>(tile) >= tilesetTiles) {
+                continue;
+            }
+
+            Rect src = {
+                region.x + (tile % tilesetColumns) * tileSize,
+                region.y + (tile / tilesetColumns) * tileSize, tileSize, tileSize};
+            Rect dst = {column * tileSize, row * tileSize, tileSize, tileSize};
+            batcher.addQuad(
+                tileset->get(), tileset->pageSize(), src, dst, {0.0f, 0.0f}, 0.0f, white);
+        }
+    }
+    batcher.flush();
+
+    SDL_SetRenderTarget(renderer_, previousTarget);
+    return texture;
+}
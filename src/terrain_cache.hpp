@@ -0,0 +1,40 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+
+#include "sprite_batcher.hpp"
+
+struct TilemapData;
+
+/// Render thread side of the tilemap terrain. Every chunk is drawn tile by tile into a render
+/// target texture the first time it is needed, afterwards the chunk costs a single quad.
+class TerrainCache {
+public:
+    explicit TerrainCache(SDL_Renderer* renderer);
+
+    /// Builds the chunk texture if needed. Switches the render target, so no batch may be pending.
+    void prepare(
+        const std::shared_ptr<const TilemapData>& tilemap, u32 chunk, SpriteBatcher& batcher);
+    /// nullptr until prepared or when building failed
+    auto chunk(const TilemapData& tilemap, u32 chunk) const -> SDL_Texture*;
+    /// Drops every chunk texture, e.g. after the renderer lost its render targets.
+    void clear();
+    /// Drops the chunk textures of tilemaps released everywhere, by their scene as well as by
+    /// the asset cache. Once per frame.
+    void releaseUnused();
+
+private:
+    struct Entry {
+        std::weak_ptr<const TilemapData> tilemap;
+        // indexed by chunk
+        std::vector<SDL_Texture*> textures;
+    };
+
+    auto build(const TilemapData& tilemap, u32 chunk, SpriteBatcher& batcher) -> SDL_Texture*;
+    static void destroy(Entry& entry);
+
+private:
+    SDL_Renderer* renderer_;
+    // keyed by tilemap id
+    std::unordered_map<u32, Entry> chunks_;
+};
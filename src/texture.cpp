@@ -1,9 +1,45 @@
 #include "texture.hpp"
 
+#include "texture_atlas.hpp"
+
+Texture::~Texture() {
+    if(atlas_ && texture_) {
+        atlas_->release(texture_);
+    }
+}
+
 void Texture::setTexture(SDL_Texture* texture) {
     texture_ = texture;
+
+    // cached, the renderer needs the size for every batched quad
+    pageSize_ = {0.0f, 0.0f};
+    if(texture_) {
+        SDL_GetTextureSize(texture_, &pageSize_.x, &pageSize_.y);
+    }
+    region_ = {0.0f, 0.0f, pageSize_.x, pageSize_.y};
+}
+
+void Texture::setAtlasRegion(SDL_Texture* page, const Rect& region) {
+    setTexture(page);
+    region_ = region;
+}
+
+void Texture::releaseTo(std::shared_ptr<TextureAtlas> atlas) {
+    atlas_ = std::move(atlas);
 }
 
 auto Texture::get() const -> SDL_Texture* {
     return texture_;
 }
+
+auto Texture::region() const -> Rect {
+    return region_;
+}
+
+auto Texture::size() const -> Vec2 {
+    return {region_.w, region_.h};
+}
+
+auto Texture::pageSize() const -> Vec2 {
+    return pageSize_;
+}
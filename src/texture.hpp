@@ -2,13 +2,36 @@
 
 #include <SDL3/SDL.h>
 
+#include <memory>
+
 #include "i_asset.hpp"
+#include "math.hpp"
+
+class TextureAtlas;
 
+/// A sprite inside a GPU texture. Small sprites share atlas pages, so every user has to address
+/// the texture through region() rather than assume it starts at the origin.
 class Texture : public IAsset {
 public:
+    Texture() = default;
+    ~Texture();
+    // the GPU texture is released once, copies would release it twice
+    Texture(const Texture&) = delete;
+    Texture& operator=(const Texture&) = delete;
+
     void setTexture(SDL_Texture* texture);
+    void setAtlasRegion(SDL_Texture* page, const Rect& region);
+    /// Hands the GPU texture back to the atlas once the texture is destroyed, the atlas frees it
+    /// on the render thread. Textures without an atlas leave theirs to the caller.
+    void releaseTo(std::shared_ptr<TextureAtlas> atlas);
     auto get() const -> SDL_Texture*;
+    auto region() const -> Rect;
+    auto size() const -> Vec2;
+    auto pageSize() const -> Vec2;
 
 private:
-    SDL_Texture* texture_;
+    SDL_Texture* texture_{nullptr};
+    Rect region_;
+    Vec2 pageSize_;
+    std::shared_ptr<TextureAtlas> atlas_;
 };
@@ -0,0 +1,189 @@
+#include "texture_atlas.hpp"
+
+#include <algorithm>
+
+#include "log.hpp"
+
+const s32 ATLAS_PAGE_SIZE = 1024;
+// empty texels kept around every sprite so filtering does not pick up the neighbours
+const s32 ATLAS_PADDING = 2;
+
+TextureAtlas::TextureAtlas() {
+}
+
+auto TextureAtlas::pageSize() -> s32 {
+    return ATLAS_PAGE_SIZE;
+}
+
+auto TextureAtlas::insert(SDL_Renderer* renderer, SDL_Surface* surface)
+    -> std::optional<AtlasRegion> {
+    s32 w = surface->w + ATLAS_PADDING * 2;
+    s32 h = surface->h + ATLAS_PADDING * 2;
+    if(w > ATLAS_PAGE_SIZE || h > ATLAS_PAGE_SIZE) {
+        return std::nullopt;
+    }
+
+    std::lock_guard lock(mutex_);
+    Page* page = nullptr;
+    size_t nodeIndex = 0;
+    std::optional<SDL_Rect> position;
+    for(auto& p : pages_) {
+        position = findPosition(p, w, h, nodeIndex);
+        if(position) {
+            page = &p;
+            break;
+        }
+    }
+
+    if(!page) {
+        page = createPage(renderer);
+        if(!page) {
+            return std::nullopt;
+        }
+        position = findPosition(*page, w, h, nodeIndex);
+        assert(position);
+    }
+
+    SDL_Surface* converted = SDL_ConvertSurface(surface, SDL_PIXELFORMAT_RGBA32);
+    if(!converted) {
+        std::string error = SDL_GetError();
+        ERROR("[TEXTURE ATLAS]: failed to convert surface - " + error);
+        return std::nullopt;
+    }
+
+    SDL_Rect target = {
+        position->x + ATLAS_PADDING, position->y + ATLAS_PADDING, surface->w, surface->h};
+    bool uploaded = SDL_UpdateTexture(page->texture, &target, converted->pixels, converted->pitch);
+    SDL_DestroySurface(converted);
+
+    if(!uploaded) {
+        std::string error = SDL_GetError();
+        ERROR("[TEXTURE ATLAS]: failed to upload sprite - " + error);
+        return std::nullopt;
+    }
+
+    place(*page, nodeIndex, position.value());
+    page->regions++;
+
+    return AtlasRegion{
+        page->texture,
+        {static_cast<f32>(target.x), static_cast<f32>(target.y), static_cast<f32>(target.w),
+            static_cast<f32>(target.h)}};
+}
+
+void TextureAtlas::release(SDL_Texture* texture) {
+    std::lock_guard lock(mutex_);
+    auto page = std::ranges::find(pages_, texture, &Page::texture);
+    if(page == pages_.end()) {
+        released_.push_back(texture);
+        return;
+    }
+    assert(page->regions > 0);
+    page->regions--;
+}
+
+void TextureAtlas::destroyReleased() {
+    std::lock_guard lock(mutex_);
+    for(auto texture : released_) {
+        SDL_DestroyTexture(texture);
+    }
+    released_.clear();
+
+    for(auto page = pages_.begin(); page != pages_.end();) {
+        if(page->regions > 0) {
+            page++;
+            continue;
+        }
+        SDL_DestroyTexture(page->texture);
+        page = pages_.erase(page);
+        INFO("[TEXTURE ATLAS]: released a page, " + std::to_string(pages_.size()) + " left");
+    }
+}
+
+auto TextureAtlas::createPage(SDL_Renderer* renderer) -> Page* {
+    SDL_Texture* texture = SDL_CreateTexture(
+        renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STATIC, ATLAS_PAGE_SIZE,
+        ATLAS_PAGE_SIZE);
+    if(!texture) {
+        std::string error = SDL_GetError();
+        ERROR("[TEXTURE ATLAS]: failed to create page - " + error);
+        return nullptr;
+    }
+    SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+
+    // start from a fully transparent page, the padding relies on it
+    std::vector<u32> clear(ATLAS_PAGE_SIZE * ATLAS_PAGE_SIZE, 0);
+    SDL_UpdateTexture(texture, nullptr, clear.data(), ATLAS_PAGE_SIZE * sizeof(u32));
+
+    Page page;
+    page.texture = texture;
+    page.skyline.push_back({0, 0, ATLAS_PAGE_SIZE});
+    pages_.push_back(std::move(page));
+
+    INFO("[TEXTURE ATLAS]: created page " + std::to_string(pages_.size()));
+    return &pages_.back();
+}
+
+auto TextureAtlas::findPosition(const Page& page, s32 w, s32 h, size_t& nodeIndex) const
+    -> std::optional<SDL_Rect> {
+    std::optional<SDL_Rect> best;
+    s32 bestWidth = 0;
+
+    for(size_t i = 0; i < page.skyline.size(); i++) {
+        s32 x = page.skyline[i].x;
+        if(x + w > ATLAS_PAGE_SIZE) {
+            break;
+        }
+
+        // the sprite rests on the highest skyline segment it spans
+        s32 y = 0;
+        s32 remaining = w;
+        for(size_t j = i; remaining > 0; j++) {
+            y = std::max(y, page.skyline[j].y);
+            remaining -= page.skyline[j].w;
+        }
+
+        if(y + h > ATLAS_PAGE_SIZE) {
+            continue;
+        }
+
+        // lowest placement wins, ties go to the narrowest segment to keep the skyline flat
+        if(!best || y < best->y || (y == best->y && page.skyline[i].w < bestWidth)) {
+            best = SDL_Rect{x, y, w, h};
+            bestWidth = page.skyline[i].w;
+            nodeIndex = i;
+        }
+    }
+    return best;
+}
+
+void TextureAtlas::place(Page& page, size_t nodeIndex, const SDL_Rect& rect) {
+    auto& skyline = page.skyline;
+    skyline.insert(skyline.begin() + nodeIndex, {rect.x, rect.y + rect.h, rect.w});
+
+    // shrink or drop the segments now covered by the new one
+    for(size_t i = nodeIndex + 1; i < skyline.size();) {
+        auto& previous = skyline[i - 1];
+        auto& node = skyline[i];
+        s32 overlap = previous.x + previous.w - node.x;
+        if(overlap <= 0) {
+            break;
+        }
+        if(overlap < node.w) {
+            node.x += overlap;
+            node.w -= overlap;
+            break;
+        }
+        skyline.erase(skyline.begin() + i);
+    }
+
+    // merge neighbours at the same height
+    for(size_t i = 0; i + 1 < skyline.size();) {
+        if(skyline[i].y == skyline[i + 1].y) {
+            skyline[i].w += skyline[i + 1].w;
+            skyline.erase(skyline.begin() + i + 1);
+        } else {
+            i++;
+        }
+    }
+}
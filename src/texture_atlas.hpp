@@ -0,0 +1,58 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+
+#include <mutex>
+#include <optional>
+
+#include "math.hpp"
+
+struct AtlasRegion {
+    SDL_Texture* page;
+    Rect rect;
+};
+
+/// Packs sprites into a growing set of large texture pages. Every page keeps a bottom-left skyline
+/// of its used area, new sprites go to the lowest spot they fit in. Pages are never repacked, the
+/// space of a released sprite is only reclaimed once every sprite on its page is released, then
+/// the whole page goes.
+class TextureAtlas {
+public:
+    TextureAtlas();
+    ~TextureAtlas() = default;
+
+    /// Copies the surface into a page and returns where it ended up. Surfaces too large to share a
+    /// page are rejected.
+    auto insert(SDL_Renderer* renderer, SDL_Surface* surface) -> std::optional<AtlasRegion>;
+    static auto pageSize() -> s32;
+    /// Gives back a sprite's page, or a texture of its own that insert rejected. Any thread, the
+    /// texture is only destroyed by destroyReleased.
+    void release(SDL_Texture* texture);
+    /// Destroys the released textures and the pages without sprites left. Render thread.
+    void destroyReleased();
+
+private:
+    struct SkylineNode {
+        s32 x;
+        s32 y;
+        s32 w;
+    };
+
+    struct Page {
+        SDL_Texture* texture;
+        std::vector<SkylineNode> skyline;
+        // sprites placed and not released yet
+        u32 regions{0};
+    };
+
+    auto createPage(SDL_Renderer* renderer) -> Page*;
+    auto findPosition(const Page& page, s32 w, s32 h, size_t& nodeIndex) const
+        -> std::optional<SDL_Rect>;
+    void place(Page& page, size_t nodeIndex, const SDL_Rect& rect);
+
+private:
+    std::vector<Page> pages_;
+    std::vector<SDL_Texture*> released_;
+    // release comes from whichever thread dropped the last reference to a texture
+    std::mutex mutex_;
+};
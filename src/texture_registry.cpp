@@ -0,0 +1,140 @@
+#include "texture_registry.hpp"
+
+#include <thread>
+
+#include "asset_manager.hpp"
+#include "log.hpp"
+
+// how long finishLoads sleeps while the loading pool is still decoding
+const std::chrono::milliseconds FINISH_LOADS_POLL_INTERVAL(1);
+// frames without a resolve before the registry lets go of a texture, about ten seconds
+const u64 TEXTURE_IDLE_FRAMES = 600;
+// the idle check walks every entry, it runs this many frames apart
+const u64 RELEASE_IDLE_INTERVAL = 60;
+
+TextureRegistry::TextureRegistry() {
+    entries_.emplace_back();
+}
+
+TextureRegistry& TextureRegistry::get() {
+    static TextureRegistry instance;
+    return instance;
+}
+
+auto TextureRegistry::acquire(const std::string& texturePath) -> TextureHandle {
+    if(texturePath.empty()) {
+        return {};
+    }
+
+    // interned before taking the lock, the asset manager's lock is never taken inside ours
+    auto asset = AssetManager::get()->intern(texturePath);
+
+    std::lock_guard lock(mutex_);
+    if(auto it = ids_.find(texturePath); it != ids_.end()) {
+        return {it->second};
+    }
+
+    u32 id = static_cast<u32>(entries_.size());
+    entries_.push_back({texturePath, asset});
+    ids_.emplace(texturePath, id);
+    return {id};
+}
+
+auto TextureRegistry::resolve(TextureHandle handle) -> Texture* {
+    AssetId asset;
+    {
+        std::lock_guard lock(mutex_);
+        if(!handle.valid() || handle.id >= entries_.size()) {
+            return nullptr;
+        }
+
+        auto& entry = entries_[handle.id];
+        entry.lastResolve = frame_;
+        if(entry.texture) {
+            return entry.texture.get();
+        }
+        if(entry.failed) {
+            return nullptr;
+        }
+        if(entry.loading.valid()) {
+            return finish(entry);
+        }
+        asset = entry.asset;
+    }
+
+    // Requested without holding the lock, loaders on the simulation thread acquire handles while
+    // the asset manager is busy. Only the render thread resolves, so nobody else loads this entry.
+    auto loading = AssetManager::get()->loadAsync<Texture>(asset);
+
+    std::lock_guard lock(mutex_);
+    auto& entry = entries_[handle.id];
+    entry.loading = loading;
+    return finish(entry);
+}
+
+void TextureRegistry::releaseIdle() {
+    bool released = false;
+    {
+        std::lock_guard lock(mutex_);
+        frame_++;
+        if(frame_ % RELEASE_IDLE_INTERVAL != 0) {
+            return;
+        }
+
+        for(auto& entry : entries_) {
+            // loads in flight are kept, their result is about to be drawn
+            if(entry.texture && frame_ - entry.lastResolve > TEXTURE_IDLE_FRAMES) {
+                entry.texture = nullptr;
+                released = true;
+            }
+        }
+    }
+
+    // stores may be skipping their eviction scans, the cache would only notice much later
+    if(released) {
+        AssetManager::get()->trim();
+    }
+}
+
+void TextureRegistry::finishLoads() {
+    while(true) {
+        {
+            std::lock_guard lock(mutex_);
+            bool loading = false;
+            for(auto& entry : entries_) {
+                if(entry.loading.valid()) {
+                    finish(entry);
+                    loading = loading || entry.loading.valid();
+                }
+            }
+            if(!loading) {
+                return;
+            }
+        }
+        AssetManager::get()->update();
+        std::this_thread::sleep_for(FINISH_LOADS_POLL_INTERVAL);
+    }
+}
+
+auto TextureRegistry::path(TextureHandle handle) const -> std::string {
+    std::lock_guard lock(mutex_);
+    if(handle.id >= entries_.size()) {
+        return {};
+    }
+    return entries_[handle.id].path;
+}
+
+auto TextureRegistry::finish(Entry& entry) -> Texture* {
+    if(!entry.loading.ready()) {
+        return nullptr;
+    }
+
+    entry.texture = entry.loading.get();
+    entry.loading = {};
+    if(!entry.texture) {
+        ERROR("[TEXTURE REGISTRY]: failed to acquire texture - " + entry.path);
+        entry.failed = true;
+        return nullptr;
+    }
+    return entry.texture.get();
+}
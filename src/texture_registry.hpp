@@ -0,0 +1,67 @@
+#pragma once
+
+#include <mutex>
+
+#include "asset_future.hpp"
+#include "asset_id.hpp"
+#include "texture.hpp"
+#include "utils.hpp"
+
+/// Dense id of a texture path. Resolved once when a component is set up, afterwards every draw
+/// addresses the texture by index instead of hashing its path.
+struct TextureHandle {
+    u32 id{0};
+
+    bool valid() const {
+        return id != 0;
+    }
+};
+
+class TextureRegistry {
+public:
+    static TextureRegistry& get();
+
+public:
+    /// Interns the path, the texture itself is loaded on first resolve. Any thread.
+    auto acquire(const std::string& texturePath) -> TextureHandle;
+    /// Returns nullptr for invalid handles and textures that failed to load. Failed loads are not
+    /// retried. The first resolve starts decoding on the loading pool and returns nullptr until
+    /// AssetManager::update uploaded the texture, so a frame never waits for a decode. Render
+    /// thread only.
+    auto resolve(TextureHandle handle) -> Texture*;
+    /// Lets go of the textures nothing resolved for a while, the asset cache may evict them then
+    /// and the next resolve loads them again. Render thread, once per frame, before resolving.
+    void releaseIdle();
+    /// Blocks until every texture resolve started loading is uploaded, for frames that have to be
+    /// complete. Render thread only.
+    void finishLoads();
+    auto path(TextureHandle handle) const -> std::string;
+
+private:
+    struct Entry {
+        std::string path;
+        AssetId asset;
+        std::shared_ptr<Texture> texture;
+        AssetFuture<Texture> loading;
+        // the frame it was last resolved in
+        u64 lastResolve{0};
+        bool failed{false};
+    };
+
+    /// Takes the texture once its load finished, the lock is held.
+    auto finish(Entry& entry) -> Texture*;
+
+    // index 0 is the invalid handle
+    std::vector<Entry> entries_;
+    std::unordered_map<std::string, u32> ids_;
+    u64 frame_{0};
+    mutable std::mutex mutex_;
+
+private:
+    TextureRegistry();
+    ~TextureRegistry() = default;
+    TextureRegistry(const TextureRegistry&) = delete;
+    TextureRegistry& operator=(const TextureRegistry&) = delete;
+    TextureRegistry(TextureRegistry&&) = delete;
+    TextureRegistry& operator=(TextureRegistry&&) = delete;
+};
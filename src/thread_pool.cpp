@@ -0,0 +1,92 @@
+#include "thread_pool.hpp"
+
+#include <atomic>
+
+const u32 LOADING_WORKER_COUNT = 2;
+
+ThreadPool::ThreadPool(u32 count) : stopping_(false) {
+    workers_.reserve(count);
+    for(u32 i = 0; i < count; i++) {
+        workers_.emplace_back([this]() { workerLoop(); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard lock(mutex_);
+        stopping_ = true;
+    }
+    condition_.notify_all();
+
+    for(auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+ThreadPool& ThreadPool::get() {
+    // leave one hardware thread for the main loop
+    static u32 hardwareThreads = std::thread::hardware_concurrency();
+    static ThreadPool instance(hardwareThreads > 1 ? hardwareThreads - 1 : 0);
+    return instance;
+}
+
+ThreadPool& ThreadPool::loading() {
+    static ThreadPool instance(LOADING_WORKER_COUNT);
+    return instance;
+}
+
+u32 ThreadPool::workerCount() const {
+    return static_cast<u32>(workers_.size());
+}
+
+void ThreadPool::parallelFor(u32 count, const std::function<void(u32)>& job) {
+    if(count == 0) {
+        return;
+    }
+
+    // indices are claimed through a shared counter, the caller included, so uneven jobs balance
+    // themselves out
+    auto next = std::make_shared<std::atomic<u32>>(0);
+    auto runJobs = [next, count, &job]() {
+        for(u32 index = next->fetch_add(1); index < count; index = next->fetch_add(1)) {
+            job(index);
+        }
+    };
+
+    u32 helpers = std::min(workerCount(), count - 1);
+    std::vector<std::future<void>> pending;
+    pending.reserve(helpers);
+    for(u32 i = 0; i < helpers; i++) {
+        pending.push_back(submit(runJobs));
+    }
+
+    runJobs();
+
+    for(auto& p : pending) {
+        p.get();
+    }
+}
+
+void ThreadPool::enqueue(std::function<void()> job) {
+    {
+        std::lock_guard lock(mutex_);
+        jobs_.push_back(std::move(job));
+    }
+    condition_.notify_one();
+}
+
+void ThreadPool::workerLoop() {
+    while(true) {
+        std::function<void()> job;
+        {
+            std::unique_lock lock(mutex_);
+            condition_.wait(lock, [this]() { return stopping_ || !jobs_.empty(); });
+            if(stopping_ && jobs_.empty()) {
+                return;
+            }
+            job = std::move(jobs_.front());
+            jobs_.pop_front();
+        }
+        job();
+    }
+}
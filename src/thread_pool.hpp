@@ -0,0 +1,66 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <thread>
+
+#include "utils.hpp"
+
+/// A fixed set of worker threads consuming a shared job queue. Jobs must not touch the entity tree
+/// or any other main-thread only state unless the caller guarantees exclusive access for the
+/// duration of the job.
+class ThreadPool {
+public:
+    static ThreadPool& get();
+    /// Separate workers for asset loading, so slow file reads never queue up in front of the jobs
+    /// of a tick.
+    static ThreadPool& loading();
+
+public:
+    u32 workerCount() const;
+
+    template <class F>
+    auto submit(F&& job) -> std::future<std::invoke_result_t<F>>;
+
+    /// Runs job(index) for every index in [0, count) and blocks until all of them finished. The
+    /// calling thread takes part in the work, so this is safe to call with no workers available.
+    void parallelFor(u32 count, const std::function<void(u32)>& job);
+
+private:
+    void enqueue(std::function<void()> job);
+    void workerLoop();
+
+private:
+    std::vector<std::thread> workers_;
+    std::deque<std::function<void()>> jobs_;
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    bool stopping_;
+
+private:
+    explicit ThreadPool(u32 count);
+    ~ThreadPool();
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    ThreadPool(ThreadPool&&) = delete;
+    ThreadPool& operator=(ThreadPool&&) = delete;
+};
+
+template <class F>
+inline auto ThreadPool::submit(F&& job) -> std::future<std::invoke_result_t<F>> {
+    using Result = std::invoke_result_t<F>;
+
+    // std::function requires a copyable target, hence the shared packaged task
+    auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(job));
+    auto future = task->get_future();
+
+    if(workers_.empty()) {
+        (*task)();
+        return future;
+    }
+
+    enqueue([task]() { (*task)(); });
+    return future;
+}
@@ -2,10 +2,12 @@
 #include <cmath>
 
 constexpr f32 MAX_FRAME_TIME = 0.25f;
+constexpr f32 DEFAULT_DELTA_TIME = 0.01f;
 
 Time::Time() :
     currentTime_(std::chrono::high_resolution_clock::now()),
-    accumulatedTime_(0.0f) {
+    accumulatedTime_(0.0f),
+    deltaTime_(DEFAULT_DELTA_TIME) {
 
 }
 
@@ -29,8 +31,8 @@ void Time::update() {
 
 bool Time::isTimeToUpdate() {
 
-    if(accumulatedTime_ >= DELTA_TIME) {
-        accumulatedTime_ -= DELTA_TIME;
+    if(accumulatedTime_ >= deltaTime_) {
+        accumulatedTime_ -= deltaTime_;
 
         return true;
     }
@@ -38,5 +40,14 @@ bool Time::isTimeToUpdate() {
 }
 
 f32 Time::alpha() {
-    return accumulatedTime_ / DELTA_TIME;
+    return accumulatedTime_ / deltaTime_;
+}
+
+f32 Time::deltaTime() const {
+    return deltaTime_;
+}
+
+void Time::setTickRate(u32 ticksPerSecond) {
+    assert(ticksPerSecond > 0);
+    deltaTime_ = 1.0f / static_cast<f32>(ticksPerSecond);
 }
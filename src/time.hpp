@@ -10,16 +10,20 @@ class Time {
 
 public:
     static Time& get();
-    const f32 DELTA_TIME = 0.01f;
 
 public:
     void update();
     bool isTimeToUpdate();
+    /// How far the accumulator is into the next step, used to blend the last two simulated states.
     f32 alpha();
+    f32 deltaTime() const;
+    /// Set before the simulation starts, rendering interpolates so lower rates still look smooth.
+    void setTickRate(u32 ticksPerSecond);
 
 private:
     TimePoint currentTime_;
     f32 accumulatedTime_;
+    f32 deltaTime_;
 
 private:
     Time();
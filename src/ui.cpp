@@ -11,6 +11,7 @@
 #include "components/spell_book.hpp"
 #include "components/tag.hpp"
 #include "components/xp.hpp"
+#include "frame_snapshot.hpp"
 #include "log.hpp"
 #include "renderer.hpp"
 #include "scene.hpp"
@@ -127,7 +128,7 @@ void UI::setupDockSpace() {
     ImGui::End();
 }
 
-void UI::render(std::shared_ptr<Scene> scene) {
+void UI::render(const FrameSnapshot& frame) {
     ImGui_ImplSDLRenderer3_NewFrame();
     ImGui_ImplSDL3_NewFrame();
     ImGui::NewFrame();
@@ -135,20 +136,11 @@ void UI::render(std::shared_ptr<Scene> scene) {
     setupDockSpace();
 
 #ifdef DEBUG
-    if(showScene_) renderSceneHierarchy(scene);
+    if(showScene_) renderSceneHierarchy(frame);
     if(showDemoWindow_) ImGui::ShowDemoWindow();
 #endif
 
-    // go through children and find player's spellbook
-    EntityPtr player = nullptr;
-    for(auto& c : scene->children()) {
-        auto tag = c->component<TagComponent>();
-        if(tag && tag->tag() == TagType::PLAYER) {
-            player = c;
-        }
-    }
-
-    renderHUD(player);
+    renderHUD(frame.hud);
 
     ImGui::Render();
 
@@ -162,15 +154,15 @@ void UI::render(std::shared_ptr<Scene> scene) {
     ImGui_ImplSDLRenderer3_RenderDrawData(ImGui::GetDrawData(), renderer->handle());
 }
 
-void UI::renderSceneHierarchy(std::shared_ptr<Scene> scene) {
+void UI::renderSceneHierarchy(const FrameSnapshot& frame) {
     ImGui::Begin("scene", nullptr, 0);
 
     ImGui::SeparatorText("Scene Hierarchy");
-    if(ImGui::TreeNode(scene->name().c_str())) {
-        for(auto& c : scene->children()) {
-            if(ImGui::TreeNode(c->name().c_str())) {
-                for(auto& comp : c->components()) {
-                    ImGui::Text("%s", comp->componentType().name());
+    if(ImGui::TreeNode(frame.sceneName.c_str())) {
+        for(auto& node : frame.sceneNodes) {
+            if(ImGui::TreeNode(node.name.c_str())) {
+                for(auto& component : node.components) {
+                    ImGui::Text("%s", component);
                 }
                 ImGui::TreePop();
             }
@@ -181,8 +173,8 @@ void UI::renderSceneHierarchy(std::shared_ptr<Scene> scene) {
     ImGui::End();
 }
 
-void UI::renderHUD(const EntityPtr& player) {
-    if(!player) {
+void UI::renderHUD(const HUDSnapshot& hud) {
+    if(!hud.hasPlayer) {
         ERROR_ONCE("[UI]: no player to render hud");
         return;
     }
@@ -192,18 +184,12 @@ void UI::renderHUD(const EntityPtr& player) {
     style.ItemSpacing = ImVec2(0, 0);
     style.WindowPadding = ImVec2(0, 0);
 
-    auto spellBook = player ? player->component<SpellBookComponent>() : nullptr;
-    auto life = player ? player->component<LifeComponent>() : nullptr;
-    auto mana = player ? player->component<ManaComponent>() : nullptr;
-    auto xp = player ? player->component<XPComponent>() : nullptr;
-
     // we need xp to get level value
-    if(!xp) {
+    if(!hud.hasXP) {
         ERROR_ONCE("[UI]: no xp component to render hud");
         return;
     }
-    u32 level = xp->level();
-    std::string playerText = player->name() + " - level " + std::to_string(level);
+    std::string playerText = hud.playerName + " - level " + std::to_string(hud.level);
     ImVec2 playerTextSize = ImGui::CalcTextSize(playerText.c_str());
 
     f32 windowWidth = ImGui::GetWindowWidth();
@@ -219,24 +205,24 @@ void UI::renderHUD(const EntityPtr& player) {
     ImGui::Text("%s", playerText.c_str());
 
     // render cast bar
-    if(!spellBook) {
+    if(!hud.hasSpellBook) {
         ERROR_ONCE("[UI]: no spellbook component to render hud");
         return;
     }
-    if(spellBook->castedSpell()) {
+    if(hud.casting) {
         ImGui::SetCursorPosX(horizontalCenter);
-        if(spellBook->interruptible()) {
+        if(hud.interruptible) {
             ImGui::PushStyleColor(ImGuiCol_PlotHistogram, ImVec4(0.4f, 0.00f, 0.4f, 1.0f));
         } else {
             ImGui::PushStyleColor(ImGuiCol_PlotHistogram, ImVec4(0.0f, 0.0f, 0.0f, 1.0f));
         }
-        auto spellName = spellBook->castedSpell() ? spellBook->castedSpell()->name.c_str() : "";
+        auto spellName = hud.castName.c_str();
         ImVec2 spellTextSize = ImGui::CalcTextSize(spellName);
         ImVec2 cursorPos = ImGui::GetCursorScreenPos();
         ImVec2 spellTextPosition = ImVec2(
             cursorPos.x + (castBarSize.x - spellTextSize.x) * 0.5f,
             cursorPos.y + (castBarSize.y - spellTextSize.y) * 0.5f);
-        ImGui::ProgressBar(spellBook->castProgress(), castBarSize, "");
+        ImGui::ProgressBar(hud.castProgress, castBarSize, "");
         ImGui::GetWindowDrawList()->AddText(
             spellTextPosition, IM_COL32(255, 255, 255, 255), spellName);
         ImGui::PopStyleColor();
@@ -248,9 +234,9 @@ void UI::renderHUD(const EntityPtr& player) {
     ImGui::SetCursorPosX(horizontalCenter);
     ImVec2 cursorPos = ImGui::GetCursorScreenPos();
 
-    bool maxLevel = xp->isMaxLevel();
-    u32 currentXP = xp->currentXP();
-    u32 nextLevelXP = xp->nextLevelXP();
+    bool maxLevel = hud.maxLevel;
+    u32 currentXP = hud.currentXP;
+    u32 nextLevelXP = hud.nextLevelXP;
     f32 progress = maxLevel ? 1.0f : static_cast<f32>(currentXP) / static_cast<f32>(nextLevelXP);
 
     std::string xpText;
@@ -270,17 +256,14 @@ void UI::renderHUD(const EntityPtr& player) {
         xpTextPosition, IM_COL32(255, 255, 255, 255), xpText.c_str());
     ImGui::PopStyleColor();
 
-    Life lifeValue;
-    Mana manaValue;
-    if(!life) {
+    if(!hud.hasLife) {
         ERROR_ONCE("[UI]: no life component to render hud");
         return;
     }
-    lifeValue = life->life();
-    auto lifeCurrent = static_cast<u32>(std::floor(lifeValue.current));
-    auto lifeMax = static_cast<u32>(std::floor(lifeValue.max));
+    auto lifeCurrent = static_cast<u32>(std::floor(hud.lifeCurrent));
+    auto lifeMax = static_cast<u32>(std::floor(hud.lifeMax));
     std::string lifeText;
-    bool dead = life->isDead();
+    bool dead = hud.dead;
     if(dead) {
         lifeText = "DEAD";
     } else {
@@ -288,47 +271,44 @@ void UI::renderHUD(const EntityPtr& player) {
     }
     ImVec2 lifeTextSize = ImGui::CalcTextSize(lifeText.c_str());
 
-    if(!mana) {
+    if(!hud.hasMana) {
         ERROR_ONCE("[UI]: no mana component to render hud");
         return;
     }
-    manaValue = mana->mana();
-    auto manaCurrent = static_cast<u32>(std::floor(manaValue.current));
-    auto manaMax = static_cast<u32>(std::floor(manaValue.max));
+    auto manaCurrent = static_cast<u32>(std::floor(hud.manaCurrent));
+    auto manaMax = static_cast<u32>(std::floor(hud.manaMax));
     std::string manaText = " " + std::to_string(manaCurrent) + "/" + std::to_string(manaMax);
     ImVec2 manaTextSize = ImGui::CalcTextSize(manaText.c_str());
 
     // render resources
     ImGui::SetCursorPosX(horizontalCenter);
-    if(life && mana) {
-        {
-            ImGui::PushStyleColor(ImGuiCol_PlotHistogram, ImVec4(0.5f, 0.0f, 0.0f, 1.0f));
-            cursorPos = ImGui::GetCursorScreenPos();
-            ImVec2 lifeTextPosition = ImVec2(
-                cursorPos.x + (resourceBarSize.x - lifeTextSize.x) * 0.5f,
-                cursorPos.y + (resourceBarSize.y - lifeTextSize.y) * 0.5f);
-            ImGui::ProgressBar(lifeValue.current / lifeValue.max, resourceBarSize, "");
-            if(dead) {
-                ImGui::GetWindowDrawList()->AddText(
-                    lifeTextPosition, IM_COL32(255, 0, 0, 255), lifeText.c_str());
-            } else {
-                ImGui::GetWindowDrawList()->AddText(
-                    lifeTextPosition, IM_COL32(255, 255, 255, 255), lifeText.c_str());
-            }
-            ImGui::PopStyleColor();
-        }
-        ImGui::SameLine();
-        {
-            ImGui::PushStyleColor(ImGuiCol_PlotHistogram, ImVec4(0.0f, 0.0f, 0.5f, 1.0f));
-            ImVec2 cursorPos = ImGui::GetCursorScreenPos();
-            ImVec2 manaTextPosition = ImVec2(
-                cursorPos.x + (resourceBarSize.x - manaTextSize.x) * 0.5f,
-                cursorPos.y + (resourceBarSize.y - manaTextSize.y) * 0.5f);
-            ImGui::ProgressBar(manaValue.current / manaValue.max, resourceBarSize, "");
+    {
+        ImGui::PushStyleColor(ImGuiCol_PlotHistogram, ImVec4(0.5f, 0.0f, 0.0f, 1.0f));
+        cursorPos = ImGui::GetCursorScreenPos();
+        ImVec2 lifeTextPosition = ImVec2(
+            cursorPos.x + (resourceBarSize.x - lifeTextSize.x) * 0.5f,
+            cursorPos.y + (resourceBarSize.y - lifeTextSize.y) * 0.5f);
+        ImGui::ProgressBar(hud.lifeCurrent / hud.lifeMax, resourceBarSize, "");
+        if(dead) {
             ImGui::GetWindowDrawList()->AddText(
-                manaTextPosition, IM_COL32(255, 255, 255, 255), manaText.c_str());
-            ImGui::PopStyleColor();
+                lifeTextPosition, IM_COL32(255, 0, 0, 255), lifeText.c_str());
+        } else {
+            ImGui::GetWindowDrawList()->AddText(
+                lifeTextPosition, IM_COL32(255, 255, 255, 255), lifeText.c_str());
         }
+        ImGui::PopStyleColor();
+    }
+    ImGui::SameLine();
+    {
+        ImGui::PushStyleColor(ImGuiCol_PlotHistogram, ImVec4(0.0f, 0.0f, 0.5f, 1.0f));
+        ImVec2 cursorPos = ImGui::GetCursorScreenPos();
+        ImVec2 manaTextPosition = ImVec2(
+            cursorPos.x + (resourceBarSize.x - manaTextSize.x) * 0.5f,
+            cursorPos.y + (resourceBarSize.y - manaTextSize.y) * 0.5f);
+        ImGui::ProgressBar(hud.manaCurrent / hud.manaMax, resourceBarSize, "");
+        ImGui::GetWindowDrawList()->AddText(
+            manaTextPosition, IM_COL32(255, 255, 255, 255), manaText.c_str());
+        ImGui::PopStyleColor();
     }
 
     // render spell slots
@@ -344,26 +324,24 @@ void UI::renderHUD(const EntityPtr& player) {
 
         for(u32 i = 0; i < 4; i++) {
             ImGui::TableSetColumnIndex(i);
-            auto spellSlots = spellBook->slots();
-            if(!spellSlots[i]) {
+            const HUDSpellSlot& slot = hud.slots[i];
+            if(slot.name.empty()) {
                 selectedSpells_[i] = SPELL_SLOT_DEFAULT;
             } else {
-                selectedSpells_[i] = spellSlots[i]->name;
+                selectedSpells_[i] = slot.name;
             }
 
             // render spell cooldown
-            f32 cooldown;
-            f32 cooldownProgress;
             ImGui::SetNextItemWidth(spellSlotSize.x);
-            if(spellBook->isSpellInSlotOnCooldown(i, &cooldown, &cooldownProgress)) {
+            if(slot.onCooldown) {
                 ImGui::PushStyleColor(ImGuiCol_PlotHistogram, ImVec4(0.8f, 0.0f, 0.0f, 1.0f));
-                std::string cooldownText = std::format("{:.2f}s", cooldown);
+                std::string cooldownText = std::format("{:.2f}s", slot.cooldown);
                 ImVec2 cooldownTextSize = ImGui::CalcTextSize(cooldownText.c_str());
                 ImVec2 cursorPos = ImGui::GetCursorScreenPos();
                 ImVec2 spellTextPosition = ImVec2(
                     cursorPos.x + (spellSlotSize.x - cooldownTextSize.x) * 0.5f,
                     cursorPos.y + (spellSlotSize.y - cooldownTextSize.y) * 0.5f);
-                ImGui::ProgressBar(cooldownProgress, spellSlotSize, "");
+                ImGui::ProgressBar(slot.cooldownProgress, spellSlotSize, "");
                 ImGui::GetWindowDrawList()->AddText(
                     spellTextPosition, IM_COL32(255, 255, 255, 255), cooldownText.c_str());
                 ImGui::PopStyleColor();
@@ -373,44 +351,41 @@ void UI::renderHUD(const EntityPtr& player) {
                 auto& selectedSpell = selectedSpells_[i];
                 bool clearSelected = false;
                 if(ImGui::BeginCombo(slotLabel.c_str(), selectedSpell.c_str())) {
-                    if(spellBook) {
-                        for(auto& spell : spellBook->spells()) {
-                            bool onCooldown = spellBook->isSpellOnCooldown(spell);
-                            bool selected = spell->name == selectedSpell;
-                            bool canSelect = true;
-                            // grey out unavailable spells
-                            for(u32 j = 0; j < selectedSpells_.size(); j++) {
-                                if(i != j && selectedSpells_[j] == spell->name) {
-                                    canSelect = false;
-                                    break;
-                                }
+                    for(auto& spell : hud.spells) {
+                        bool selected = spell.name == selectedSpell;
+                        bool canSelect = true;
+                        // grey out unavailable spells
+                        for(u32 j = 0; j < selectedSpells_.size(); j++) {
+                            if(i != j && selectedSpells_[j] == spell.name) {
+                                canSelect = false;
+                                break;
                             }
-                            if(onCooldown || !canSelect) {
-                                ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(0.5, 0.5, 0.5, 1.0f));
-                                ImGui::Selectable(
-                                    spell->name.c_str(), &selected, ImGuiSelectableFlags_Disabled);
-                                ImGui::PopStyleColor();
+                        }
+                        if(spell.onCooldown || !canSelect) {
+                            ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(0.5, 0.5, 0.5, 1.0f));
+                            ImGui::Selectable(
+                                spell.name.c_str(), &selected, ImGuiSelectableFlags_Disabled);
+                            ImGui::PopStyleColor();
+                        }
+                        // normal selection
+                        else {
+                            if(ImGui::Selectable(spell.name.c_str(), &selected)) {
+                                selectedSpell = spell.name;
+                                commands_.push_back({i, spell.name});
                             }
-                            // normal selection
-                            else {
-                                if(ImGui::Selectable(spell->name.c_str(), &selected)) {
-                                    selectedSpell = spell->name;
-                                }
-
-                                if(selected) {
-                                    ImGui::SetItemDefaultFocus();
-                                    spellBook->setSlot(i, spell);
-                                }
+
+                            if(selected) {
+                                ImGui::SetItemDefaultFocus();
                             }
                         }
-                        // add clear slot option
-                        ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(1.0, 0.0, 0.0, 1.0f));
-                        if(ImGui::Selectable("X Clear Slot X", &clearSelected)) {
-                            selectedSpell = SPELL_SLOT_DEFAULT;
-                            spellBook->setSlot(i, nullptr);
-                        }
-                        ImGui::PopStyleColor();
                     }
+                    // add clear slot option
+                    ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(1.0, 0.0, 0.0, 1.0f));
+                    if(ImGui::Selectable("X Clear Slot X", &clearSelected)) {
+                        selectedSpell = SPELL_SLOT_DEFAULT;
+                        commands_.push_back({i, ""});
+                    }
+                    ImGui::PopStyleColor();
                     ImGui::EndCombo();
                 }
             }
@@ -420,3 +395,120 @@ void UI::renderHUD(const EntityPtr& player) {
     ImGui::PopStyleVar();
     ImGui::End();
 }
+
+auto UI::takeCommands() -> std::vector<UICommand> {
+    std::vector<UICommand> commands;
+    std::swap(commands, commands_);
+    return commands;
+}
+
+void UI::capture(const std::shared_ptr<Scene>& scene, FrameSnapshot& frame) {
+#ifdef DEBUG
+    frame.sceneName = scene->name();
+    auto children = scene->children();
+    frame.sceneNodes.resize(children.size());
+    for(size_t i = 0; i < children.size(); i++) {
+        auto& node = frame.sceneNodes[i];
+        node.name = children[i]->name();
+        node.components.clear();
+        for(auto& component : children[i]->components()) {
+            node.components.push_back(component->componentType().name());
+        }
+    }
+#endif
+
+    HUDSnapshot& hud = frame.hud;
+    auto player = findPlayer(scene);
+    hud.hasPlayer = player != nullptr;
+    if(!player) {
+        return;
+    }
+
+    auto xp = player->component<XPComponent>();
+    hud.hasXP = xp != nullptr;
+    if(xp) {
+        hud.playerName = player->name();
+        hud.level = xp->level();
+        hud.maxLevel = xp->isMaxLevel();
+        hud.currentXP = xp->currentXP();
+        hud.nextLevelXP = xp->nextLevelXP();
+    }
+
+    auto spellBook = player->component<SpellBookComponent>();
+    hud.hasSpellBook = spellBook != nullptr;
+    if(spellBook) {
+        auto castedSpell = spellBook->castedSpell();
+        hud.casting = castedSpell != nullptr;
+        if(castedSpell) {
+            hud.interruptible = spellBook->interruptible();
+            hud.castName = castedSpell->name;
+            hud.castProgress = spellBook->castProgress();
+        }
+
+        auto slots = spellBook->slots();
+        for(u32 i = 0; i < hud.slots.size(); i++) {
+            auto& slot = hud.slots[i];
+            if(slots[i]) {
+                slot.name = slots[i]->name;
+            } else {
+                slot.name.clear();
+            }
+            slot.onCooldown =
+                spellBook->isSpellInSlotOnCooldown(i, &slot.cooldown, &slot.cooldownProgress);
+        }
+
+        auto spells = spellBook->spells();
+        hud.spells.resize(spells.size());
+        for(size_t i = 0; i < spells.size(); i++) {
+            hud.spells[i].name = spells[i]->name;
+            hud.spells[i].onCooldown = spellBook->isSpellOnCooldown(spells[i]);
+        }
+    }
+
+    auto life = player->component<LifeComponent>();
+    hud.hasLife = life != nullptr;
+    if(life) {
+        hud.dead = life->isDead();
+        hud.lifeCurrent = life->life().current;
+        hud.lifeMax = life->life().max;
+    }
+
+    auto mana = player->component<ManaComponent>();
+    hud.hasMana = mana != nullptr;
+    if(mana) {
+        hud.manaCurrent = mana->mana().current;
+        hud.manaMax = mana->mana().max;
+    }
+}
+
+void UI::apply(const std::shared_ptr<Scene>& scene, const UICommand& command) {
+    auto player = findPlayer(scene);
+    auto spellBook = player ? player->component<SpellBookComponent>() : nullptr;
+    if(!spellBook) {
+        return;
+    }
+
+    if(command.spellName.empty()) {
+        spellBook->setSlot(command.spellSlot, nullptr);
+        return;
+    }
+
+    for(auto& spell : spellBook->spells()) {
+        if(spell->name == command.spellName) {
+            spellBook->setSlot(command.spellSlot, spell);
+            return;
+        }
+    }
+}
+
+auto UI::findPlayer(const std::shared_ptr<Scene>& scene) -> EntityPtr {
+    // go through children and find player
+    EntityPtr player = nullptr;
+    for(auto& c : scene->children()) {
+        auto tag = c->component<TagComponent>();
+        if(tag && tag->tag() == TagType::PLAYER) {
+            player = c;
+        }
+    }
+    return player;
+}
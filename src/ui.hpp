@@ -5,9 +5,20 @@
 #include "utils.hpp"
 
 struct ImGuiContext;
+struct FrameSnapshot;
+struct HUDSnapshot;
 class Scene;
 class Renderer;
 
+/// A gameplay change requested through the ui, applied by the simulation thread.
+struct UICommand {
+    u32 spellSlot;
+    // empty to clear the slot
+    std::string spellName;
+};
+
+/// Draws on the render thread from frame snapshots only. The capture and apply functions are the
+/// simulation side and the only parts touching the scene.
 class UI {
 public:
     UI();
@@ -15,12 +26,19 @@ public:
 
     bool init(SDL_Window* window, std::shared_ptr<Renderer> renderer);
     void handleEvents(const SDL_Event& event);
-    void render(std::shared_ptr<Scene> scene);
-    void renderSceneHierarchy(std::shared_ptr<Scene> scene);
-    void renderHUD(const EntityPtr& player);
+    void render(const FrameSnapshot& frame);
+    void renderSceneHierarchy(const FrameSnapshot& frame);
+    void renderHUD(const HUDSnapshot& hud);
+    /// Commands issued since the last call.
+    auto takeCommands() -> std::vector<UICommand>;
+
+    /// simulation thread
+    static void capture(const std::shared_ptr<Scene>& scene, FrameSnapshot& frame);
+    static void apply(const std::shared_ptr<Scene>& scene, const UICommand& command);
 
 private:
     void setupDockSpace();
+    static auto findPlayer(const std::shared_ptr<Scene>& scene) -> EntityPtr;
 
 private:
     std::weak_ptr<Renderer> renderer_;
@@ -29,6 +47,7 @@ private:
     bool imguiSDL3RendererInitResult_;
     bool firstTime_;
     std::array<std::string, 4> selectedSpells_;
+    std::vector<UICommand> commands_;
 
 #ifdef DEBUG
     bool showScene_;
@@ -21,6 +21,7 @@ using f32 = float;
 using d64 = double;
 using s32 = int32_t;
 using u32 = uint32_t;
+using u64 = uint64_t;
 
 class Entity;
 class ComponentBase;
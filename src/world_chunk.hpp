@@ -0,0 +1,10 @@
+#pragma once
+
+#include "i_asset.hpp"
+#include "scene.hpp"
+
+/// The entities of one chunk of a streamed scene, see WorldStreamer. Their prefabs are loaded
+/// together with the chunk, so activating it never waits for the disk.
+struct WorldChunkData : public IAsset {
+    std::vector<QueuedEntity> entities;
+};
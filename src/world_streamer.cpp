@@ -0,0 +1,264 @@
+#include "world_streamer.hpp"
+
+#include "asset_manager.hpp"
+#include "binary_io.hpp"
+#include "component.hpp"
+#include "components/player_control.hpp"
+#include "scene.hpp"
+
+// chunks within this many chunks of the player's are active, a 3x3 area
+const s32 ACTIVE_CHUNK_RADIUS = 1;
+// and loaded in the background within this many
+const s32 LOADED_CHUNK_RADIUS = 2;
+// chunks are let go one chunk further out than they are taken in, walking along a chunk border
+// does not stream the chunks behind it in and out with every step
+const s32 CHUNK_HYSTERESIS = 1;
+
+WorldStreamer::WorldStreamer(f32 chunkSize, const std::string& chunkDirectory)
+    : chunkSize_(chunkSize), chunkDirectory_(chunkDirectory) {
+}
+
+void WorldStreamer::update(Scene& scene, std::chrono::microseconds budget) {
+    auto player = findPlayer(scene);
+    if(!player) {
+        return;
+    }
+    bool unbounded = budget == std::chrono::microseconds::zero();
+    auto deadline = unbounded ? std::chrono::steady_clock::time_point::max()
+                              : std::chrono::steady_clock::now() + budget;
+    auto center = coordOf(player->transform().position);
+
+    // Collected first, deactivating adds the chunks entities walked into. Elements of the map
+    // stay where they are when it grows, its iterators do not.
+    std::vector<Chunk*> leaving;
+    for(auto it = chunks_.begin(); it != chunks_.end();) {
+        auto& [key, chunk] = *it;
+        s32 chunkDistance = distance(chunk.coord, center);
+        if(chunk.state == ChunkState::ACTIVE &&
+           chunkDistance > ACTIVE_CHUNK_RADIUS + CHUNK_HYSTERESIS) {
+            leaving.push_back(&chunk);
+        } else if(
+            chunk.state != ChunkState::ACTIVE &&
+            chunkDistance > LOADED_CHUNK_RADIUS + CHUNK_HYSTERESIS) {
+            // Nothing to remember, coming back recreates it as it is. A visited chunk with a file
+            // is kept even when empty, its entities were killed and must stay dead.
+            if(chunk.saved.empty() && (!chunk.visited || missingChunks_.contains(key))) {
+                it = chunks_.erase(it);
+                continue;
+            }
+            unload(chunk);
+        }
+        ++it;
+    }
+    for(auto chunk : leaving) {
+        deactivate(scene, *chunk);
+    }
+
+    for(s32 y = center.y - LOADED_CHUNK_RADIUS; y <= center.y + LOADED_CHUNK_RADIUS; y++) {
+        for(s32 x = center.x - LOADED_CHUNK_RADIUS; x <= center.x + LOADED_CHUNK_RADIUS; x++) {
+            auto& chunk = chunkAt({x, y});
+            load(chunk, unbounded);
+            if(chunk.state == ChunkState::LOADED &&
+               distance(chunk.coord, center) <= ACTIVE_CHUNK_RADIUS) {
+                activate(chunk);
+            }
+        }
+    }
+
+    for(s32 y = center.y - ACTIVE_CHUNK_RADIUS; y <= center.y + ACTIVE_CHUNK_RADIUS; y++) {
+        for(s32 x = center.x - ACTIVE_CHUNK_RADIUS; x <= center.x + ACTIVE_CHUNK_RADIUS; x++) {
+            auto& chunk = chunkAt({x, y});
+            if(chunk.state == ChunkState::ACTIVE && !createEntities(scene, chunk, deadline)) {
+                return;
+            }
+        }
+    }
+}
+
+auto WorldStreamer::findPlayer(Scene& scene) -> EntityPtr {
+    if(auto player = player_.lock()) {
+        return player;
+    }
+    for(auto& child : scene.children()) {
+        if(child->component<PlayerControlComponent>()) {
+            player_ = child;
+            return child;
+        }
+    }
+    return nullptr;
+}
+
+auto WorldStreamer::coordOf(const Vec2& position) const -> ChunkCoord {
+    return {
+        static_cast<s32>(std::floor(position.x / chunkSize_)),
+        static_cast<s32>(std::floor(position.y / chunkSize_))};
+}
+
+auto WorldStreamer::chunkAt(ChunkCoord coord) -> Chunk& {
+    auto [it, inserted] = chunks_.try_emplace(chunkKey(coord));
+    if(inserted) {
+        it->second.coord = coord;
+    }
+    return it->second;
+}
+
+auto WorldStreamer::chunkPath(ChunkCoord coord) const -> std::string {
+    return chunkDirectory_ + "/" + std::to_string(coord.x) + "_" + std::to_string(coord.y) +
+           ".json";
+}
+
+void WorldStreamer::load(Chunk& chunk, bool wait) {
+    if(chunk.state == ChunkState::UNLOADED) {
+        auto am = AssetManager::get();
+        auto key = chunkKey(chunk.coord);
+        auto path = chunkPath(chunk.coord);
+        // most of a map is usually empty, those chunks simply have no file
+        if(missingChunks_.contains(key) || !am->exists(path)) {
+            missingChunks_.insert(key);
+            chunk.state = ChunkState::LOADED;
+            return;
+        }
+        if(wait) {
+            chunk.data = am->load<WorldChunkData>(path);
+            chunk.state = ChunkState::LOADED;
+            return;
+        }
+        chunk.loading = am->loadAsync<WorldChunkData>(path);
+        chunk.state = ChunkState::LOADING;
+    }
+
+    if(chunk.state == ChunkState::LOADING && (wait || chunk.loading.ready())) {
+        // a chunk that failed to load stays empty, the loader reported why
+        chunk.data = chunk.loading.wait();
+        chunk.loading = {};
+        chunk.state = ChunkState::LOADED;
+    }
+}
+
+void WorldStreamer::activate(Chunk& chunk) {
+    if(!chunk.visited && chunk.data) {
+        for(auto& entity : chunk.data->entities) {
+            chunk.saved.push_back({entity.name, entity.prefab, entity.transform, {}});
+        }
+    }
+    chunk.visited = true;
+    chunk.state = ChunkState::ACTIVE;
+}
+
+void WorldStreamer::deactivate(Scene& scene, Chunk& chunk) {
+    for(auto& streamed : chunk.entities) {
+        auto entity = streamed.entity.lock();
+        // killed meanwhile, it stays dead
+        if(!entity || entity->parent().get() != &scene) {
+            continue;
+        }
+
+        // it may have walked into a chunk that stays active
+        auto& target = chunkAt(coordOf(entity->transform().position));
+        if(&target != &chunk && target.state == ChunkState::ACTIVE) {
+            target.entities.push_back(streamed);
+            continue;
+        }
+
+        target.saved.push_back(
+            {entity->name(), streamed.prefab, entity->transform(), saveState(*entity)});
+        scene.removeChild(entity);
+    }
+    chunk.entities.clear();
+    chunk.state = ChunkState::LOADED;
+}
+
+void WorldStreamer::unload(Chunk& chunk) {
+    // saved entities are kept, they are all that is left of them
+    chunk.data = nullptr;
+    chunk.loading = {};
+    chunk.state = ChunkState::UNLOADED;
+}
+
+bool WorldStreamer::createEntities(
+    Scene& scene, Chunk& chunk, std::chrono::steady_clock::time_point deadline) {
+    while(!chunk.saved.empty()) {
+        auto saved = std::move(chunk.saved.back());
+        chunk.saved.pop_back();
+        createEntity(scene, chunk, saved);
+
+        if(std::chrono::steady_clock::now() >= deadline) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void WorldStreamer::createEntity(Scene& scene, Chunk& chunk, const SavedEntity& saved) {
+    // usually cached, the chunk's data holds on to the prefabs of its file
+    auto source = AssetManager::get()->load<EntityData>(saved.prefab);
+    if(!source) {
+        return;
+    }
+    auto entity = scene.entityCreator().createEntity(saved.name, source);
+    if(!entity) {
+        ERROR("[WORLD STREAMER]: failed to create entity " + saved.name);
+        return;
+    }
+    entity->setTransform(saved.transform);
+    // attached right away, the scene is
+    scene.addChild(entity);
+
+    if(!saved.state.empty()) {
+        loadState(*entity, saved.state);
+    }
+    chunk.entities.push_back({entity, saved.prefab});
+}
+
+auto WorldStreamer::saveState(const Entity& entity) -> std::vector<char> {
+    // the state never leaves the process, the type's hash identifies it well enough
+    BinaryWriter records;
+    u32 count = 0;
+    for(auto& component : entity.components()) {
+        BinaryWriter state;
+        component->saveState(state);
+        if(state.data().empty()) {
+            continue;
+        }
+        records.writeU64(component->componentType().hash_code());
+        records.writeU32(static_cast<u32>(state.data().size()));
+        records.writeBytes(state.data());
+        count++;
+    }
+    if(count == 0) {
+        return {};
+    }
+
+    BinaryWriter writer;
+    writer.writeU32(count);
+    writer.writeBytes(records.data());
+    return writer.data();
+}
+
+void WorldStreamer::loadState(Entity& entity, std::span<const char> state) {
+    BinaryReader reader(std::as_bytes(state));
+    u32 count = reader.readU32();
+    for(u32 i = 0; i < count && reader.ok(); i++) {
+        u64 type = reader.readU64();
+        auto bytes = reader.readBytes(reader.readU32());
+        if(!reader.ok()) {
+            break;
+        }
+        for(auto& component : entity.components()) {
+            if(component->componentType().hash_code() == type) {
+                BinaryReader record(std::as_bytes(bytes));
+                component->loadState(record);
+                break;
+            }
+        }
+    }
+}
+
+auto WorldStreamer::chunkKey(ChunkCoord coord) -> u64 {
+    return (static_cast<u64>(static_cast<u32>(coord.x)) << 32) |
+           static_cast<u64>(static_cast<u32>(coord.y));
+}
+
+auto WorldStreamer::distance(ChunkCoord a, ChunkCoord b) -> s32 {
+    return std::max(std::abs(a.x - b.x), std::abs(a.y - b.y));
+}
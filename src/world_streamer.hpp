@@ -0,0 +1,90 @@
+#pragma once
+
+#include "asset_future.hpp"
+#include "asset_id.hpp"
+#include "math.hpp"
+#include "world_chunk.hpp"
+
+class Scene;
+
+/// Divides a scene into square chunks of world space. Each chunk has its own file of entities,
+/// "<x>_<y>.json" in the scene's chunk directory, chunks without one are empty. The chunks
+/// around the player are active, their entities are children of the scene. Chunks a bit further
+/// out are loaded in the background. When the player moves away, the entities of a chunk are
+/// saved to compact state and removed. Simulation and memory then follow the area around the
+/// player instead of the size of the map.
+///
+/// Entities of the scene file itself, like the player, and everything spawned while playing stay
+/// children of the scene and are never streamed.
+class WorldStreamer {
+public:
+    WorldStreamer(f32 chunkSize, const std::string& chunkDirectory);
+
+    /// Follows the player, creating the entities of newly active chunks until the budget is spent.
+    /// A zero budget loads the chunks right away instead of in the background and creates all
+    /// entities, so the world only depends on the ticks, as headless runs need. Simulation thread,
+    /// between ticks.
+    void update(Scene& scene, std::chrono::microseconds budget);
+
+private:
+    struct ChunkCoord {
+        s32 x, y;
+    };
+
+    enum class ChunkState { UNLOADED, LOADING, LOADED, ACTIVE };
+
+    /// What is left of an entity of an inactive chunk.
+    struct SavedEntity {
+        std::string name;
+        AssetId prefab;
+        Transform transform;
+        // a record per component with state, tagged with its type, see saveState
+        std::vector<char> state;
+    };
+
+    struct StreamedEntity {
+        EntityHandle entity;
+        AssetId prefab;
+    };
+
+    struct Chunk {
+        ChunkCoord coord;
+        ChunkState state{ChunkState::UNLOADED};
+        AssetFuture<WorldChunkData> loading;
+        // keeps the prefabs cached while the player is around
+        std::shared_ptr<WorldChunkData> data;
+        // the chunk file is only instantiated once, afterwards its entities come from saved
+        bool visited{false};
+        std::vector<SavedEntity> saved;
+        std::vector<StreamedEntity> entities;
+    };
+
+    auto findPlayer(Scene& scene) -> EntityPtr;
+    auto coordOf(const Vec2& position) const -> ChunkCoord;
+    auto chunkAt(ChunkCoord coord) -> Chunk&;
+    auto chunkPath(ChunkCoord coord) const -> std::string;
+    void load(Chunk& chunk, bool wait);
+    void activate(Chunk& chunk);
+    void deactivate(Scene& scene, Chunk& chunk);
+    void unload(Chunk& chunk);
+    /// Returns false once the deadline passed.
+    bool createEntities(
+        Scene& scene, Chunk& chunk, std::chrono::steady_clock::time_point deadline);
+    void createEntity(Scene& scene, Chunk& chunk, const SavedEntity& saved);
+    /// Writes each component's state as a record of its type, size and bytes. A hot reloaded
+    /// prefab may add, remove or reorder components, loadState hands every record to the
+    /// component of its type and skips records no component of the entity claims.
+    static auto saveState(const Entity& entity) -> std::vector<char>;
+    static void loadState(Entity& entity, std::span<const char> state);
+
+    static auto chunkKey(ChunkCoord coord) -> u64;
+    static auto distance(ChunkCoord a, ChunkCoord b) -> s32;
+
+private:
+    f32 chunkSize_;
+    std::string chunkDirectory_;
+    std::unordered_map<u64, Chunk> chunks_;
+    // chunks without a file, looked up once instead of on every return of the player
+    std::unordered_set<u64> missingChunks_;
+    EntityHandle player_;
+};
@@ -0,0 +1,70 @@
+#include <SDL3/SDL.h>
+
+#include "asset_manager.hpp"
+#include "loaders/animation_loader.hpp"
+#include "loaders/emitter_loader.hpp"
+#include "loaders/entity_loader.hpp"
+#include "loaders/particle_loader.hpp"
+#include "loaders/scene_loader.hpp"
+#include "loaders/spell_loader.hpp"
+#include "loaders/status_effect_loader.hpp"
+#include "loaders/texture_loader.hpp"
+#include "loaders/tilemap_loader.hpp"
+#include "loaders/world_chunk_loader.hpp"
+
+// Cooks every asset reachable from the scenes under <asset root>/scenes. An output ending in .pack
+// becomes a single pack file, anything else a cooked root of loose blobs. The game picks up both
+// and falls back to the sources for the rest.
+int main(int argc, char const* argv[]) {
+	if(argc != 3) {
+		ERROR("usage: ces_cook <asset root> <cooked root | pack file>");
+		return 1;
+	}
+	std::filesystem::path output(argv[2]);
+	bool packed = output.extension() == ".pack";
+
+	// images are decoded into surfaces, no video subsystem needed
+	if(!SDL_Init(0)) {
+		ERROR(SDL_GetError());
+		return 1;
+	}
+
+	auto am = AssetManager::get();
+	am->setAssetRoot(argv[1]);
+	if(!packed) {
+		am->setCookedRoot(argv[2]);
+	}
+
+	auto sceneLoader = std::make_shared<SceneLoader>();
+	am->registerLoader<SpellData>(std::make_shared<SpellLoader>());
+	am->registerLoader<Scene>(sceneLoader);
+	am->registerLoader<EntityData>(std::make_shared<EntityLoader>());
+	// textures are only decoded, nothing is uploaded
+	am->registerLoader<Texture>(std::make_shared<TextureLoader>(nullptr));
+	am->registerLoader<AnimationData>(std::make_shared<AnimationLoader>());
+	am->registerLoader<StatusEffectData>(std::make_shared<StatusEffectLoader>());
+	am->registerLoader<EmitterData>(std::make_shared<EmitterLoader>());
+	am->registerLoader<ParticleData>(std::make_shared<ParticleLoader>());
+	am->registerLoader<TilemapData>(std::make_shared<TilemapLoader>());
+	am->registerLoader<WorldChunkData>(std::make_shared<WorldChunkLoader>());
+
+	std::vector<AssetReference> roots;
+	std::error_code error;
+	auto scenes = am->getAssetPath("scenes");
+	for(auto& entry : std::filesystem::recursive_directory_iterator(scenes, error)) {
+		if(entry.is_regular_file() && entry.path().extension() == ".json") {
+			auto references = sceneLoader->sceneReferences(entry.path().generic_string());
+			roots.insert(roots.end(), references.begin(), references.end());
+		}
+	}
+
+	if(error) {
+		ERROR("failed to list " + scenes.generic_string() + " - " + error.message());
+		SDL_Quit();
+		return 1;
+	}
+
+	u32 failed = am->cook(roots, packed ? output.generic_string() : "");
+	SDL_Quit();
+	return failed == 0 ? 0 : 1;
+}